@@ -0,0 +1,21 @@
+#include "Allocations.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+thread_local size_t allocations = 0;
+}  // namespace
+
+size_t tinyorm_bench::Allocations() { return allocations; }
+
+// The array and nothrow forms of the standard library forward to these.
+void* operator new(size_t size) {
+    ++allocations;
+    if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+
+namespace tinyorm_bench {
+
+//! Number of `operator new` calls made by the calling thread so far.
+size_t Allocations();
+
+/**
+ * @brief Counts the allocations between `Start()` and `Stop()` of every
+ * iteration, and reports their average per iteration as the counter `name`
+ * when it goes out of scope.
+ */
+class AllocationCounter {
+public:
+    AllocationCounter(benchmark::State& state, const char* name)
+        : state_(state), name_(name) {}
+    AllocationCounter(const AllocationCounter&) = delete;
+    AllocationCounter& operator=(const AllocationCounter&) = delete;
+    ~AllocationCounter() {
+        state_.counters[name_] = benchmark::Counter(
+            static_cast<double>(total_), benchmark::Counter::kAvgIterations);
+    }
+
+    inline void Start() { start_ = Allocations(); }
+    inline void Stop() { total_ += Allocations() - start_; }
+
+private:
+    benchmark::State& state_;
+    const char* name_;
+    size_t start_ = 0;
+    size_t total_ = 0;
+};
+
+}  // namespace tinyorm_bench
@@ -0,0 +1,87 @@
+#include <benchmark/benchmark.h>
+
+#include "tinyorm.h"
+
+using namespace std;
+using namespace tinyorm;
+using namespace tinyorm_impl;
+
+namespace {
+
+struct Record {
+    long long ID;
+    string Name;
+    double Price;
+    int Count;
+    Nullable<string> Comment;
+    REFLECTION("Record", ID, Name, Price, Count, Comment);
+};
+
+constexpr long long ROWS = 1000000;
+
+Sqlite3& Table() {
+    static Sqlite3 db(":memory:");
+    static bool populated = false;
+    if (!populated) {
+        db.Execute(
+            "create table Record(ID integer primary key, Name text, "
+            "Price real, Count integer, Comment text);");
+        db.Execute("begin transaction;");
+        for (long long i = 0; i < ROWS; ++i) {
+            db.Execute("insert into Record values (?,?,?,?,?);",
+                       {i, "Name-" + to_string(i), i * 0.25,
+                        static_cast<long long>(i % 1000),
+                        i % 2 ? BoundValue{nullptr}
+                              : BoundValue{string("Comment")}});
+        }
+        db.Execute("commit transaction;");
+        populated = true;
+    }
+    return db;
+}
+
+// Every cell comes back as text and is parsed by an istringstream.
+void BM_DecodeText(benchmark::State& state) {
+    auto& db = Table();
+    for (auto _ : state) {
+        vector<Record> out;
+        Record row;
+        db.ExecuteCallback("select * from Record;",
+                           [&row, &out](int, char** argv) {
+                               ReflectionVisitor::Visit(
+                                   row, [argv](auto&... args) {
+                                       size_t idx = 0;
+                                       (Deserializer::Deserialize(args,
+                                                                  argv[idx++]),
+                                        ...);
+                                   });
+                               out.push_back(row);
+                           });
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * ROWS);
+}
+
+// Every cell is read by the column accessor of its reflected type.
+void BM_DecodeNative(benchmark::State& state) {
+    auto& db = Table();
+    for (auto _ : state) {
+        vector<Record> out;
+        Record row;
+        db.ExecuteCallback(
+            "select * from Record;", {}, [&row, &out](sqlite3_stmt* stmt) {
+                ReflectionVisitor::Visit(row, [stmt](auto&... args) {
+                    int idx = 0;
+                    (Deserializer::Deserialize(args, stmt, idx++), ...);
+                });
+                out.push_back(row);
+            });
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * ROWS);
+}
+
+}  // namespace
+
+BENCHMARK(BM_DecodeText)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DecodeNative)->Unit(benchmark::kMillisecond);
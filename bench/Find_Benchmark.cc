@@ -0,0 +1,183 @@
+#include <benchmark/benchmark.h>
+
+#include "Allocations.h"
+#include "tinyorm.h"
+
+using namespace std;
+using namespace tinyorm;
+using namespace tinyorm_impl;
+
+namespace {
+
+struct Account {
+    long long ID;
+    string Owner;
+    double Balance;
+    Nullable<string> Email;
+    REFLECTION("Account", ID, Owner, Balance, Email);
+};
+
+constexpr long long ROWS = 100000;
+
+DBManager<Sqlite3>& Accounts() {
+    static DBManager<Sqlite3> dbm(":memory:");
+    static bool populated = false;
+    if (!populated) {
+        dbm.CreateTbl(Account{});
+        vector<Account> accounts;
+        accounts.reserve(ROWS);
+        for (long long i = 0; i < ROWS; ++i)
+            accounts.push_back({i, "Owner-" + to_string(i), i * 0.5,
+                                string("owner@example.com")});
+        dbm.InsertRange(accounts);
+        populated = true;
+    }
+    return dbm;
+}
+
+// The lookup as it had to be written before Find.
+void BM_FindByQuery(benchmark::State& state) {
+    auto& dbm = Accounts();
+    Account account;
+    long long key = 0;
+    tinyorm_bench::AllocationCounter allocations(state, "allocs/lookup");
+    for (auto _ : state) {
+        allocations.Start();
+        FieldExtractor field{account};
+        auto rows = dbm.Query(Account{})
+                        .Where(field(account.ID) == key++ % ROWS)
+                        .ToVector();
+        allocations.Stop();
+        benchmark::DoNotOptimize(rows.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_Find(benchmark::State& state) {
+    auto& dbm = Accounts();
+    long long key = 0;
+    tinyorm_bench::AllocationCounter allocations(state, "allocs/lookup");
+    for (auto _ : state) {
+        allocations.Start();
+        auto row = dbm.Find<Account>(key++ % ROWS);
+        allocations.Stop();
+        benchmark::DoNotOptimize(row);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Hand written sqlite3 calls on a statement prepared once.
+void BM_FindRaw(benchmark::State& state) {
+    Accounts();
+    sqlite3* db;
+    sqlite3_open(":memory:", &db);
+    sqlite3_exec(db,
+                 "create table Account(ID integer primary key, Owner text, "
+                 "Balance real, Email text);",
+                 nullptr, nullptr, nullptr);
+    sqlite3_stmt* insert;
+    sqlite3_prepare_v2(db, "insert into Account values (?,?,?,?);", -1,
+                       &insert, nullptr);
+    sqlite3_exec(db, "begin;", nullptr, nullptr, nullptr);
+    for (long long i = 0; i < ROWS; ++i) {
+        auto owner = "Owner-" + to_string(i);
+        sqlite3_bind_int64(insert, 1, i);
+        sqlite3_bind_text(insert, 2, owner.data(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_double(insert, 3, i * 0.5);
+        sqlite3_bind_text(insert, 4, "owner@example.com", -1, SQLITE_STATIC);
+        sqlite3_step(insert);
+        sqlite3_reset(insert);
+    }
+    sqlite3_exec(db, "commit;", nullptr, nullptr, nullptr);
+    sqlite3_finalize(insert);
+    sqlite3_stmt* stmt;
+    sqlite3_prepare_v2(db,
+                       "select ID,Owner,Balance,Email from Account "
+                       "where Account.ID=?;",
+                       -1, &stmt, nullptr);
+    long long key = 0;
+    tinyorm_bench::AllocationCounter allocations(state, "allocs/lookup");
+    for (auto _ : state) {
+        allocations.Start();
+        Account row;
+        sqlite3_bind_int64(stmt, 1, key++ % ROWS);
+        if (sqlite3_step(stmt) == SQLITE_ROW) {
+            row.ID = sqlite3_column_int64(stmt, 0);
+            row.Owner.assign(
+                reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1)),
+                sqlite3_column_bytes(stmt, 1));
+            row.Balance = sqlite3_column_double(stmt, 2);
+            if (sqlite3_column_type(stmt, 3) != SQLITE_NULL)
+                row.Email = string(
+                    reinterpret_cast<const char*>(sqlite3_column_text(stmt, 3)),
+                    sqlite3_column_bytes(stmt, 3));
+        }
+        sqlite3_reset(stmt);
+        allocations.Stop();
+        benchmark::DoNotOptimize(row);
+    }
+    sqlite3_finalize(stmt);
+    sqlite3_close(db);
+    state.SetItemsProcessed(state.iterations());
+}
+
+vector<long long> Keys(long long count) {
+    vector<long long> keys;
+    for (long long i = 0; i < count; ++i) keys.push_back(i * 97 % ROWS);
+    return keys;
+}
+
+// `range(0)` keys through one query joining `==` terms with `||`; a few
+// hundred terms already overflow the SQLite parser stack.
+void BM_GetByOrChain(benchmark::State& state) {
+    auto& dbm = Accounts();
+    auto keys = Keys(state.range(0));
+    Account account;
+    FieldExtractor field{account};
+    tinyorm_bench::AllocationCounter allocations(state, "allocs/batch");
+    for (auto _ : state) {
+        allocations.Start();
+        auto filter = field(account.ID) == keys[0];
+        for (size_t i = 1; i < keys.size(); ++i)
+            filter = std::move(filter) || field(account.ID) == keys[i];
+        auto rows = dbm.Query(Account{}).Where(filter).ToVector();
+        allocations.Stop();
+        benchmark::DoNotOptimize(rows.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_FindMany(benchmark::State& state) {
+    auto& dbm = Accounts();
+    auto keys = Keys(state.range(0));
+    tinyorm_bench::AllocationCounter allocations(state, "allocs/batch");
+    for (auto _ : state) {
+        allocations.Start();
+        auto rows = dbm.FindMany<Account>(keys);
+        allocations.Stop();
+        benchmark::DoNotOptimize(rows.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_GetByIds(benchmark::State& state) {
+    auto& dbm = Accounts();
+    auto keys = Keys(state.range(0));
+    tinyorm_bench::AllocationCounter allocations(state, "allocs/batch");
+    for (auto _ : state) {
+        allocations.Start();
+        auto rows = dbm.GetByIds<Account>(keys);
+        allocations.Stop();
+        benchmark::DoNotOptimize(rows.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+BENCHMARK(BM_FindByQuery);
+BENCHMARK(BM_Find);
+BENCHMARK(BM_FindRaw);
+BENCHMARK(BM_GetByOrChain)->Arg(10)->Arg(50);
+BENCHMARK(BM_FindMany)->Arg(10)->Arg(500)->Arg(5000);
+BENCHMARK(BM_GetByIds)->Arg(10)->Arg(500)->Arg(5000);
@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+
+#include <sstream>
+
+#include "tinyorm.h"
+
+using namespace std;
+using namespace tinyorm;
+using namespace tinyorm_impl;
+
+namespace {
+
+struct Item {
+    long long ID;
+    string Name;
+    double Price;
+    int Count;
+    Nullable<string> Comment;
+    REFLECTION("Item", ID, Name, Price, Count, Comment);
+};
+
+vector<Item> Items(long long rows) {
+    vector<Item> items;
+    items.reserve(rows);
+    for (long long i = 0; i < rows; ++i) {
+        items.push_back({i, "Name-" + to_string(i), i * 0.25,
+                         static_cast<int>(i % 1000), string("Comment")});
+    }
+    return items;
+}
+
+// Every entity is serialized into a literal insert statement, and the
+// script of all of them runs in a single Execute, as InsertRange used to do.
+void BM_InsertText(benchmark::State& state) {
+    const auto items = Items(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        DBManager<Sqlite3> dbm(":memory:");
+        dbm.CreateTbl(Item{});
+        state.ResumeTiming();
+        ostringstream os;
+        for (const auto& item : items) {
+            os << "insert into Item(ID,Name,Price,Count,Comment) values (";
+            Serializer::Serialize(os, item.ID);
+            os << ",";
+            Serializer::Serialize(os, item.Name);
+            os << ",";
+            Serializer::Serialize(os, item.Price);
+            os << ",";
+            Serializer::Serialize(os, item.Count);
+            os << ",";
+            Serializer::Serialize(os, item.Comment);
+            os << ");";
+        }
+        dbm.Backend().Execute(os.str());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_InsertPerRow(benchmark::State& state) {
+    const auto items = Items(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        DBManager<Sqlite3> dbm(":memory:");
+        dbm.CreateTbl(Item{});
+        state.ResumeTiming();
+        dbm.InsertRange(items);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_InsertMultiRow(benchmark::State& state) {
+    const auto items = Items(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        DBManager<Sqlite3> dbm(":memory:");
+        dbm.CreateTbl(Item{});
+        state.ResumeTiming();
+        dbm.InsertRange(items, true, InsertMode::MultiRow);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+BENCHMARK(BM_InsertText)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_InsertPerRow)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_InsertMultiRow)->Arg(100000)->Unit(benchmark::kMillisecond);
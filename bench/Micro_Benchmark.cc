@@ -0,0 +1,202 @@
+#include <benchmark/benchmark.h>
+
+#include <sstream>
+
+#include "Allocations.h"
+#include "tinyorm.h"
+
+using namespace std;
+using namespace tinyorm;
+using namespace tinyorm_impl;
+
+// The building blocks of a small query, without any I/O: value
+// serialization, column decoding, expression building, field lookup and
+// query builders. Every benchmark reports the `operator new` calls of one
+// operation.
+
+namespace {
+
+struct Product {
+    long long ID;
+    string Name;
+    double Price;
+    int Stock;
+    Nullable<string> Note;
+    REFLECTION("Product", ID, Name, Price, Stock, Note);
+};
+
+struct Vendor {
+    long long ID;
+    string Name;
+    REFLECTION("Vendor", ID, Name);
+};
+
+// The values of a row inlined as SQL literals, as DDL and ToString do.
+void BM_Serialize(benchmark::State& state) {
+    const Product product{42, "Keyboard", 19.5, 7, nullptr};
+    ostringstream os;
+    tinyorm_bench::AllocationCounter allocations(state, "allocs/row");
+    for (auto _ : state) {
+        allocations.Start();
+        os.str("");
+        Serializer::Serialize(os, product.ID);
+        Serializer::Serialize(os, product.Name);
+        Serializer::Serialize(os, product.Price);
+        Serializer::Serialize(os, product.Stock);
+        Serializer::Serialize(os, product.Note);
+        allocations.Stop();
+        benchmark::DoNotOptimize(os);
+    }
+}
+
+// The same values converted for binding to placeholders.
+void BM_ToBound(benchmark::State& state) {
+    const Product product{42, "Keyboard", 19.5, 7, nullptr};
+    tinyorm_bench::AllocationCounter allocations(state, "allocs/row");
+    for (auto _ : state) {
+        allocations.Start();
+        BoundValues values{Serializer::ToBound(product.ID),
+                           Serializer::ToBound(product.Name),
+                           Serializer::ToBound(product.Price),
+                           Serializer::ToBound(product.Stock),
+                           Serializer::ToBound(product.Note)};
+        allocations.Stop();
+        benchmark::DoNotOptimize(values.data());
+    }
+}
+
+// A row decoded from text, as the callback of `sqlite3_exec` delivers it.
+void BM_DeserializeText(benchmark::State& state) {
+    const char* row[] = {"42", "Keyboard", "19.5", "7", nullptr};
+    Product product{};
+    tinyorm_bench::AllocationCounter allocations(state, "allocs/row");
+    for (auto _ : state) {
+        allocations.Start();
+        Deserializer::Deserialize(product.ID, row[0]);
+        Deserializer::Deserialize(product.Name, row[1]);
+        Deserializer::Deserialize(product.Price, row[2]);
+        Deserializer::Deserialize(product.Stock, row[3]);
+        Deserializer::Deserialize(product.Note, row[4]);
+        allocations.Stop();
+        benchmark::DoNotOptimize(product);
+    }
+}
+
+// The same row decoded from a statement stepped once.
+void BM_DeserializeNative(benchmark::State& state) {
+    sqlite3* db;
+    sqlite3_open(":memory:", &db);
+    sqlite3_stmt* stmt;
+    sqlite3_prepare_v2(db, "select 42,'Keyboard',19.5,7,null;", -1, &stmt,
+                       nullptr);
+    sqlite3_step(stmt);
+    Product product{};
+    tinyorm_bench::AllocationCounter allocations(state, "allocs/row");
+    for (auto _ : state) {
+        allocations.Start();
+        Deserializer::Deserialize(product.ID, stmt, 0);
+        Deserializer::Deserialize(product.Name, stmt, 1);
+        Deserializer::Deserialize(product.Price, stmt, 2);
+        Deserializer::Deserialize(product.Stock, stmt, 3);
+        Deserializer::Deserialize(product.Note, stmt, 4);
+        allocations.Stop();
+        benchmark::DoNotOptimize(product);
+    }
+    sqlite3_finalize(stmt);
+    sqlite3_close(db);
+}
+
+// `range(0)` terms alternately joined by `&&` and `||` to a named filter,
+// which the const& operators copy at every step: the quadratic pattern the
+// RelationExpr docs warn about.
+void BM_RelationCompose(benchmark::State& state) {
+    Product product;
+    FieldExtractor field{product};
+    const auto cheap = field(product.Price) < 10.0;
+    const auto stocked = field(product.Stock) > 0;
+    tinyorm_bench::AllocationCounter allocations(state, "allocs/filter");
+    for (auto _ : state) {
+        allocations.Start();
+        auto filter = cheap;
+        for (int64_t i = 1; i < state.range(0); ++i)
+            filter = i % 2 ? filter && stocked : filter || cheap;
+        allocations.Stop();
+        benchmark::DoNotOptimize(&filter);
+    }
+}
+
+// The same filter moved into every step, which appends in place.
+void BM_RelationComposeMoved(benchmark::State& state) {
+    Product product;
+    FieldExtractor field{product};
+    tinyorm_bench::AllocationCounter allocations(state, "allocs/filter");
+    for (auto _ : state) {
+        allocations.Start();
+        auto filter = field(product.Price) < 10.0;
+        for (int64_t i = 1; i < state.range(0); ++i)
+            filter = i % 2 ? std::move(filter) && field(product.Stock) > 0
+                           : std::move(filter) || field(product.Price) < 10.0;
+        allocations.Stop();
+        benchmark::DoNotOptimize(&filter);
+    }
+}
+
+void BM_ExtractorConstruct(benchmark::State& state) {
+    Product product;
+    Vendor vendor;
+    tinyorm_bench::AllocationCounter allocations(state, "allocs/extractor");
+    for (auto _ : state) {
+        allocations.Start();
+        FieldExtractor field{product, vendor};
+        allocations.Stop();
+        benchmark::DoNotOptimize(&field);
+    }
+}
+
+// The last field of the second object, the longest search.
+void BM_ExtractorLookup(benchmark::State& state) {
+    Product product;
+    Vendor vendor;
+    FieldExtractor field{product, vendor};
+    tinyorm_bench::AllocationCounter allocations(state, "allocs/field");
+    for (auto _ : state) {
+        allocations.Start();
+        auto name = field(vendor.Name);
+        allocations.Stop();
+        benchmark::DoNotOptimize(&name);
+    }
+}
+
+// A join query with every builder step, built but not run.
+void BM_QueryBuild(benchmark::State& state) {
+    static DBManager<Sqlite3> dbm(":memory:");
+    Product product;
+    Vendor vendor;
+    FieldExtractor field{product, vendor};
+    tinyorm_bench::AllocationCounter allocations(state, "allocs/query");
+    for (auto _ : state) {
+        allocations.Start();
+        auto query = dbm.Query(product)
+                         .Join(vendor, field(product.ID) == field(vendor.ID))
+                         .Select(field(product.Name), field(vendor.Name))
+                         .Where(field(product.Price) < 10.0)
+                         .GroupBy(field(vendor.Name))
+                         .OrderBy(field(product.Name))
+                         .Limit(20)
+                         .Offset(40);
+        allocations.Stop();
+        benchmark::DoNotOptimize(&query);
+    }
+}
+
+}  // namespace
+
+BENCHMARK(BM_Serialize);
+BENCHMARK(BM_ToBound);
+BENCHMARK(BM_DeserializeText);
+BENCHMARK(BM_DeserializeNative);
+BENCHMARK(BM_RelationCompose)->Arg(2)->Arg(8)->Arg(32);
+BENCHMARK(BM_RelationComposeMoved)->Arg(2)->Arg(8)->Arg(32);
+BENCHMARK(BM_ExtractorConstruct);
+BENCHMARK(BM_ExtractorLookup);
+BENCHMARK(BM_QueryBuild);
@@ -0,0 +1,413 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <memory>
+
+#include "tinyorm.h"
+
+using namespace std;
+using namespace tinyorm;
+using namespace tinyorm_impl;
+
+// Every operation of the ORM next to the same statements written against
+// the sqlite3 API, on an in-memory (Arg 0) and a file-backed (Arg 1)
+// database. The difference between a pair is the cost of the ORM.
+
+namespace {
+
+struct Item {
+    long long ID;
+    string Name;
+    double Price;
+    int Count;
+    Nullable<string> Comment;
+    REFLECTION("Item", ID, Name, Price, Count, Comment);
+};
+
+struct Tag {
+    long long ID;
+    long long ItemID;
+    string Label;
+    REFLECTION("Tag", ID, ItemID, Label);
+};
+
+constexpr long long ROWS = 10000;
+constexpr int COUNTS = 1000;       // Rows sharing a Count: ROWS / COUNTS
+constexpr long long BATCH = 1000;  // Rows of InsertRange and UpdateRange
+
+Item MakeItem(long long id) {
+    return {id, "Name-" + to_string(id), id * 0.25,
+            static_cast<int>(id % COUNTS), string("Comment")};
+}
+
+vector<Item> Items(long long first, long long count) {
+    vector<Item> items;
+    items.reserve(count);
+    for (long long i = first; i < first + count; ++i)
+        items.push_back(MakeItem(i));
+    return items;
+}
+
+//! A fresh database file, or `:memory:`.
+string Database(int64_t storage, const string& name) {
+    if (storage == 0) return ":memory:";
+    string file = "tinyorm_bench_" + name + ".db";
+    for (const char* suffix : {"", "-wal", "-shm", "-journal"})
+        std::remove((file + suffix).c_str());
+    return file;
+}
+
+Sqlite3Options FileOptions() {
+    Sqlite3Options options;
+    options.journalMode = Sqlite3Options::JournalMode::Wal;
+    options.synchronous = Sqlite3Options::Synchronous::Normal;
+    return options;
+}
+
+unique_ptr<DBManager<Sqlite3>> Orm(int64_t storage) {
+    auto dbm = make_unique<DBManager<Sqlite3>>(Database(storage, "orm"),
+                                               FileOptions());
+    Item item;
+    Tag tag;
+    FieldExtractor field{item, tag};
+    dbm->CreateTbl(item);
+    dbm->CreateTbl(tag);
+    dbm->CreateIndex(item, "Item_Count", field(item.Count));
+    dbm->CreateIndex(tag, "Tag_ItemID", field(tag.ItemID));
+    dbm->InsertRange(Items(0, ROWS));
+    vector<Tag> tags;
+    for (long long i = 0; i < ROWS; ++i)
+        tags.push_back({i, i, "Label-" + to_string(i)});
+    dbm->InsertRange(tags);
+    return dbm;
+}
+
+//! The same schema and rows through the sqlite3 API.
+class Raw {
+public:
+    explicit Raw(int64_t storage) {
+        sqlite3_open(Database(storage, "raw").c_str(), &db_);
+        Exec("PRAGMA journal_mode = WAL; PRAGMA synchronous = NORMAL;");
+        Exec("create table Item(ID integer not null primary key,"
+             "Name text not null,Price real not null,"
+             "Count integer not null,Comment text);"
+             "create table Tag(ID integer not null primary key,"
+             "ItemID integer not null,Label text not null);"
+             "create index Item_Count on Item(Count);"
+             "create index Tag_ItemID on Tag(ItemID);");
+        Exec("begin;");
+        auto insert = Prepare("insert into Item values (?,?,?,?,?);");
+        for (const auto& item : Items(0, ROWS)) {
+            BindItem(insert, item);
+            Run(insert);
+        }
+        auto tag = Prepare("insert into Tag values (?,?,?);");
+        for (long long i = 0; i < ROWS; ++i) {
+            auto label = "Label-" + to_string(i);
+            sqlite3_bind_int64(tag, 1, i);
+            sqlite3_bind_int64(tag, 2, i);
+            sqlite3_bind_text(tag, 3, label.data(), -1, SQLITE_TRANSIENT);
+            Run(tag);
+        }
+        Exec("commit;");
+    }
+    Raw(const Raw&) = delete;
+    Raw& operator=(const Raw&) = delete;
+    ~Raw() {
+        for (auto stmt : stmts_) sqlite3_finalize(stmt);
+        sqlite3_close(db_);
+    }
+
+    void Exec(const char* sql) {
+        sqlite3_exec(db_, sql, nullptr, nullptr, nullptr);
+    }
+
+    //! Compiled once, like the statement cache of the ORM.
+    sqlite3_stmt* Prepare(const char* sql) {
+        sqlite3_stmt* stmt;
+        sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr);
+        stmts_.push_back(stmt);
+        return stmt;
+    }
+
+    static void Run(sqlite3_stmt* stmt) {
+        sqlite3_step(stmt);
+        sqlite3_reset(stmt);
+    }
+
+    //! Bind Name, Price, Count and Comment from `first` on.
+    static void BindFields(sqlite3_stmt* stmt, const Item& item, int first) {
+        sqlite3_bind_text(stmt, first, item.Name.data(),
+                          static_cast<int>(item.Name.size()), SQLITE_STATIC);
+        sqlite3_bind_double(stmt, first + 1, item.Price);
+        sqlite3_bind_int(stmt, first + 2, item.Count);
+        if (item.Comment.HasValue())
+            sqlite3_bind_text(stmt, first + 3, item.Comment.Value().data(),
+                              -1, SQLITE_STATIC);
+        else
+            sqlite3_bind_null(stmt, first + 3);
+    }
+
+    static void BindItem(sqlite3_stmt* stmt, const Item& item) {
+        sqlite3_bind_int64(stmt, 1, item.ID);
+        BindFields(stmt, item, 2);
+    }
+
+    static string Text(sqlite3_stmt* stmt, int col) {
+        return string(
+            reinterpret_cast<const char*>(sqlite3_column_text(stmt, col)),
+            sqlite3_column_bytes(stmt, col));
+    }
+
+    static Item Decode(sqlite3_stmt* stmt) {
+        Item item;
+        item.ID = sqlite3_column_int64(stmt, 0);
+        item.Name = Text(stmt, 1);
+        item.Price = sqlite3_column_double(stmt, 2);
+        item.Count = sqlite3_column_int(stmt, 3);
+        if (sqlite3_column_type(stmt, 4) != SQLITE_NULL)
+            item.Comment = Text(stmt, 4);
+        return item;
+    }
+
+private:
+    sqlite3* db_ = nullptr;
+    vector<sqlite3_stmt*> stmts_;
+};
+
+void BM_OrmInsert(benchmark::State& state) {
+    auto dbm = Orm(state.range(0));
+    auto item = MakeItem(0);
+    for (auto _ : state) dbm->Insert(item, false);
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_RawInsert(benchmark::State& state) {
+    Raw raw(state.range(0));
+    auto insert =
+        raw.Prepare("insert into Item(Name,Price,Count,Comment) values "
+                    "(?,?,?,?);");
+    auto item = MakeItem(0);
+    for (auto _ : state) {
+        Raw::BindFields(insert, item, 1);
+        Raw::Run(insert);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_OrmInsertRange(benchmark::State& state) {
+    auto dbm = Orm(state.range(0));
+    const auto items = Items(0, BATCH);
+    for (auto _ : state) dbm->InsertRange(items, false);
+    state.SetItemsProcessed(state.iterations() * BATCH);
+}
+
+void BM_RawInsertRange(benchmark::State& state) {
+    Raw raw(state.range(0));
+    auto insert =
+        raw.Prepare("insert into Item(Name,Price,Count,Comment) values "
+                    "(?,?,?,?);");
+    const auto items = Items(0, BATCH);
+    for (auto _ : state) {
+        raw.Exec("begin;");
+        for (const auto& item : items) {
+            Raw::BindFields(insert, item, 1);
+            Raw::Run(insert);
+        }
+        raw.Exec("commit;");
+    }
+    state.SetItemsProcessed(state.iterations() * BATCH);
+}
+
+void BM_OrmUpdate(benchmark::State& state) {
+    auto dbm = Orm(state.range(0));
+    auto item = MakeItem(0);
+    for (auto _ : state) {
+        item.ID = (item.ID + 1) % ROWS;
+        item.Price += 1;
+        dbm->Update(item);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_RawUpdate(benchmark::State& state) {
+    Raw raw(state.range(0));
+    auto update = raw.Prepare(
+        "update Item set Name=?,Price=?,Count=?,Comment=? where ID=?;");
+    auto item = MakeItem(0);
+    for (auto _ : state) {
+        item.ID = (item.ID + 1) % ROWS;
+        item.Price += 1;
+        Raw::BindFields(update, item, 1);
+        sqlite3_bind_int64(update, 5, item.ID);
+        Raw::Run(update);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_OrmUpdateRange(benchmark::State& state) {
+    auto dbm = Orm(state.range(0));
+    auto items = Items(0, BATCH);
+    for (auto _ : state) {
+        for (auto& item : items) item.Price += 1;
+        dbm->UpdateRange(items);
+    }
+    state.SetItemsProcessed(state.iterations() * BATCH);
+}
+
+void BM_RawUpdateRange(benchmark::State& state) {
+    Raw raw(state.range(0));
+    auto update = raw.Prepare(
+        "update Item set Name=?,Price=?,Count=?,Comment=? where ID=?;");
+    auto items = Items(0, BATCH);
+    for (auto _ : state) {
+        raw.Exec("begin;");
+        for (auto& item : items) {
+            item.Price += 1;
+            Raw::BindFields(update, item, 1);
+            sqlite3_bind_int64(update, 5, item.ID);
+            Raw::Run(update);
+        }
+        raw.Exec("commit;");
+    }
+    state.SetItemsProcessed(state.iterations() * BATCH);
+}
+
+// A row is deleted and inserted back, so that every iteration deletes one.
+void BM_OrmDelete(benchmark::State& state) {
+    auto dbm = Orm(state.range(0));
+    auto item = MakeItem(0);
+    for (auto _ : state) {
+        item.ID = (item.ID + 1) % ROWS;
+        dbm->Delete(item);
+        dbm->Insert(item);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_RawDelete(benchmark::State& state) {
+    Raw raw(state.range(0));
+    auto remove = raw.Prepare("delete from Item where ID=?;");
+    auto insert = raw.Prepare("insert into Item values (?,?,?,?,?);");
+    auto item = MakeItem(0);
+    for (auto _ : state) {
+        item.ID = (item.ID + 1) % ROWS;
+        sqlite3_bind_int64(remove, 1, item.ID);
+        Raw::Run(remove);
+        Raw::BindItem(insert, item);
+        Raw::Run(insert);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_OrmQuery(benchmark::State& state) {
+    auto dbm = Orm(state.range(0));
+    Item item;
+    FieldExtractor field{item};
+    int count = 0;
+    for (auto _ : state) {
+        auto rows = dbm->Query(Item{})
+                        .Where(field(item.Count) == count++ % COUNTS)
+                        .ToVector();
+        benchmark::DoNotOptimize(rows.data());
+    }
+    state.SetItemsProcessed(state.iterations() * (ROWS / COUNTS));
+}
+
+void BM_RawQuery(benchmark::State& state) {
+    Raw raw(state.range(0));
+    auto select = raw.Prepare("select * from Item where Count=?;");
+    int count = 0;
+    for (auto _ : state) {
+        vector<Item> rows;
+        sqlite3_bind_int(select, 1, count++ % COUNTS);
+        while (sqlite3_step(select) == SQLITE_ROW)
+            rows.push_back(Raw::Decode(select));
+        sqlite3_reset(select);
+        benchmark::DoNotOptimize(rows.data());
+    }
+    state.SetItemsProcessed(state.iterations() * (ROWS / COUNTS));
+}
+
+void BM_OrmJoin(benchmark::State& state) {
+    auto dbm = Orm(state.range(0));
+    Item item;
+    Tag tag;
+    FieldExtractor field{item, tag};
+    int count = 0;
+    for (auto _ : state) {
+        auto rows = dbm->Query(Item{})
+                        .Join(Tag{}, field(tag.ItemID) == field(item.ID))
+                        .Select(field(item.Name), field(tag.Label))
+                        .Where(field(item.Count) == count++ % COUNTS)
+                        .ToVector();
+        benchmark::DoNotOptimize(rows.data());
+    }
+    state.SetItemsProcessed(state.iterations() * (ROWS / COUNTS));
+}
+
+void BM_RawJoin(benchmark::State& state) {
+    Raw raw(state.range(0));
+    auto select = raw.Prepare(
+        "select Item.Name,Tag.Label from Item join Tag on Tag.ItemID=Item.ID "
+        "where Item.Count=?;");
+    int count = 0;
+    for (auto _ : state) {
+        vector<pair<string, string>> rows;
+        sqlite3_bind_int(select, 1, count++ % COUNTS);
+        while (sqlite3_step(select) == SQLITE_ROW)
+            rows.emplace_back(Raw::Text(select, 0), Raw::Text(select, 1));
+        sqlite3_reset(select);
+        benchmark::DoNotOptimize(rows.data());
+    }
+    state.SetItemsProcessed(state.iterations() * (ROWS / COUNTS));
+}
+
+void BM_OrmAggregate(benchmark::State& state) {
+    auto dbm = Orm(state.range(0));
+    Item item;
+    FieldExtractor field{item};
+    int count = 0;
+    for (auto _ : state) {
+        auto sum = dbm->Query(Item{})
+                       .Where(field(item.Count) == count++ % COUNTS)
+                       .Aggregate(Sum(field(item.Price)));
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_RawAggregate(benchmark::State& state) {
+    Raw raw(state.range(0));
+    auto select = raw.Prepare("select sum(Price) from Item where Count=?;");
+    int count = 0;
+    for (auto _ : state) {
+        Nullable<double> sum;
+        sqlite3_bind_int(select, 1, count++ % COUNTS);
+        if (sqlite3_step(select) == SQLITE_ROW &&
+            sqlite3_column_type(select, 0) != SQLITE_NULL)
+            sum = sqlite3_column_double(select, 0);
+        sqlite3_reset(select);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+BENCHMARK(BM_OrmInsert)->Arg(0)->Arg(1);
+BENCHMARK(BM_RawInsert)->Arg(0)->Arg(1);
+BENCHMARK(BM_OrmInsertRange)->Arg(0)->Arg(1);
+BENCHMARK(BM_RawInsertRange)->Arg(0)->Arg(1);
+BENCHMARK(BM_OrmUpdate)->Arg(0)->Arg(1);
+BENCHMARK(BM_RawUpdate)->Arg(0)->Arg(1);
+BENCHMARK(BM_OrmUpdateRange)->Arg(0)->Arg(1);
+BENCHMARK(BM_RawUpdateRange)->Arg(0)->Arg(1);
+BENCHMARK(BM_OrmDelete)->Arg(0)->Arg(1);
+BENCHMARK(BM_RawDelete)->Arg(0)->Arg(1);
+BENCHMARK(BM_OrmQuery)->Arg(0)->Arg(1);
+BENCHMARK(BM_RawQuery)->Arg(0)->Arg(1);
+BENCHMARK(BM_OrmJoin)->Arg(0)->Arg(1);
+BENCHMARK(BM_RawJoin)->Arg(0)->Arg(1);
+BENCHMARK(BM_OrmAggregate)->Arg(0)->Arg(1);
+BENCHMARK(BM_RawAggregate)->Arg(0)->Arg(1);
@@ -0,0 +1,157 @@
+#include <benchmark/benchmark.h>
+
+#include "Allocations.h"
+#include "tinyorm.h"
+
+using namespace std;
+using namespace tinyorm;
+using namespace tinyorm_impl;
+
+namespace {
+
+struct Order {
+    long long ID;
+    string Customer;
+    double Amount;
+    int Status;
+    Nullable<string> Note;
+    REFLECTION("Orders", ID, Customer, Amount, Status, Note);
+};
+
+DBManager<Sqlite3>& Orders() {
+    static DBManager<Sqlite3> dbm(":memory:");
+    static bool created = false;
+    if (!created) {
+        dbm.CreateTbl(Order{});
+        created = true;
+    }
+    return dbm;
+}
+
+// Five builder steps on temporaries, then the query runs on an empty table,
+// so the counted allocations are the ones of the query itself.
+void BM_QueryChain(benchmark::State& state) {
+    auto& dbm = Orders();
+    Order order;
+    FieldExtractor field{order};
+    tinyorm_bench::AllocationCounter allocations(state, "allocs/query");
+    for (auto _ : state) {
+        allocations.Start();
+        auto rows = dbm.Query(order)
+                        .Where(field(order.Amount) > 10.0)
+                        .OrderBy(field(order.Customer))
+                        .OrderByDescending(field(order.Amount))
+                        .Limit(20)
+                        .Offset(40)
+                        .ToVector();
+        allocations.Stop();
+        benchmark::DoNotOptimize(rows.data());
+    }
+}
+
+// The same query built from named steps, which go through the const&
+// builders.
+void BM_QuerySteps(benchmark::State& state) {
+    auto& dbm = Orders();
+    Order order;
+    FieldExtractor field{order};
+    tinyorm_bench::AllocationCounter allocations(state, "allocs/query");
+    for (auto _ : state) {
+        allocations.Start();
+        const auto query = dbm.Query(order);
+        const auto filtered = query.Where(field(order.Amount) > 10.0);
+        const auto sorted = filtered.OrderBy(field(order.Customer));
+        const auto reversed = sorted.OrderByDescending(field(order.Amount));
+        const auto limited = reversed.Limit(20);
+        auto rows = limited.Offset(40).ToVector();
+        allocations.Stop();
+        benchmark::DoNotOptimize(rows.data());
+    }
+}
+
+// A filter of `range(0)` terms joined by `and`, built and rendered.
+void BM_FilterChain(benchmark::State& state) {
+    Order order;
+    FieldExtractor field{order};
+    auto amount = field(order.Amount);
+    tinyorm_bench::AllocationCounter allocations(state, "allocs/filter");
+    for (auto _ : state) {
+        allocations.Start();
+        auto filter = amount > 0.0;
+        for (int64_t i = 1; i < state.range(0); ++i)
+            filter = std::move(filter) && amount != static_cast<double>(i);
+        auto sql = filter.ToSql();
+        allocations.Stop();
+        benchmark::DoNotOptimize(sql.data());
+    }
+}
+
+// The same three-term filter, as a RelationExpr and as an expression
+// template, run against the empty table.
+void BM_FilterDynamic(benchmark::State& state) {
+    auto& dbm = Orders();
+    Order order;
+    FieldExtractor field{order};
+    tinyorm_bench::AllocationCounter allocations(state, "allocs/query");
+    for (auto _ : state) {
+        allocations.Start();
+        auto rows = dbm.Query(order)
+                        .Where(field(order.Amount) > 10.0 &&
+                               (field(order.Status) == 1 ||
+                                field(order.Customer) == string("Rose")))
+                        .ToVector();
+        allocations.Stop();
+        benchmark::DoNotOptimize(rows.data());
+    }
+}
+
+void BM_FilterStatic(benchmark::State& state) {
+    auto& dbm = Orders();
+    Order order;
+    FieldExtractor field{order};
+    tinyorm_bench::AllocationCounter allocations(state, "allocs/query");
+    for (auto _ : state) {
+        allocations.Start();
+        auto rows = dbm.Query(order)
+                        .Where(field.Static(order.Amount) > 10.0 &&
+                               (field.Static(order.Status) == 1 ||
+                                field.Static(order.Customer) == string("Rose")))
+                        .ToVector();
+        allocations.Stop();
+        benchmark::DoNotOptimize(rows.data());
+    }
+}
+
+// A two-term filter named through FieldExtractor, and through member
+// pointers.
+void BM_ColumnExtractor(benchmark::State& state) {
+    Order order;
+    FieldExtractor field{order};
+    tinyorm_bench::AllocationCounter allocations(state, "allocs/expr");
+    for (auto _ : state) {
+        allocations.Start();
+        auto expr = field(order.Amount) > 10.0 && field(order.Status) == 1;
+        allocations.Stop();
+        benchmark::DoNotOptimize(&expr);
+    }
+}
+
+void BM_ColumnMember(benchmark::State& state) {
+    tinyorm_bench::AllocationCounter allocations(state, "allocs/expr");
+    for (auto _ : state) {
+        allocations.Start();
+        auto expr = Col(&Order::Amount) > 10.0 && Col(&Order::Status) == 1;
+        allocations.Stop();
+        benchmark::DoNotOptimize(&expr);
+    }
+}
+
+}  // namespace
+
+BENCHMARK(BM_QueryChain);
+BENCHMARK(BM_QuerySteps);
+BENCHMARK(BM_FilterChain)->Arg(10)->Arg(50)->Arg(200);
+BENCHMARK(BM_FilterDynamic);
+BENCHMARK(BM_FilterStatic);
+BENCHMARK(BM_ColumnExtractor);
+BENCHMARK(BM_ColumnMember);
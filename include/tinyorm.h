@@ -3,18 +3,38 @@
 
 #include <sqlite3.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
 #include <chrono>
+#include <condition_variable>
 #include <cstddef>
+#include <cstdint>
+#include <cstdlib>
 #include <functional>
+#include <future>
+#include <iterator>
 #include <list>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
 #include <sstream>
 #include <string>
 #include <string_view>
 #include <thread>
 #include <type_traits>
+#include <unordered_map>
+#include <variant>
 #include <vector>
 
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#define TINYORM_HAS_COROUTINE 1
+#endif
+
 #define REFLECTION(_TABLE_NAME_, ...)                        \
 private:                                                     \
     friend class tinyorm_impl::ReflectionVisitor;            \
@@ -37,12 +57,12 @@ private:                                                     \
                                               std::is_arithmetic<T2>::value>>  \
     inline auto operator OP(LHS_TYPE field, RHS_TYPE value) {                  \
         std::string expression = "(";                                          \
-        if (field.tableName_) expression += (*field.tableName_ + ".");         \
-        expression += field.fieldName_ + #OP + std::to_string(value) + ")";    \
+        field.AppendTo(expression);                                            \
+        expression.append(#OP).append(std::to_string(value)) += ")";           \
         if constexpr (std::is_convertible<T1, T2>::value) {                    \
-            return CalculateField<T2>(expression);                             \
+            return CalculateField<T2>(std::move(expression));                  \
         } else {                                                               \
-            return CalculateField<T1>(expression);                             \
+            return CalculateField<T1>(std::move(expression));                  \
         }                                                                      \
     }
 
@@ -51,13 +71,14 @@ private:                                                     \
               class Enable = std::enable_if_t<std::is_arithmetic<T1>::value && \
                                               std::is_arithmetic<T2>::value>>  \
     inline auto operator OP(LHS_TYPE value, RHS_TYPE field) {                  \
-        std::string expression = "(" + std::to_string(value) + #OP;            \
-        if (field.tableName_) expression += (*field.tableName_ + ".");         \
-        expression += field.fieldName_ + ")";                                  \
+        std::string expression = "(";                                          \
+        expression.append(std::to_string(value)).append(#OP);                  \
+        field.AppendTo(expression);                                            \
+        expression += ")";                                                     \
         if constexpr (std::is_convertible<T1, T2>::value) {                    \
-            return CalculateField<T2>(expression);                             \
+            return CalculateField<T2>(std::move(expression));                  \
         } else {                                                               \
-            return CalculateField<T1>(expression);                             \
+            return CalculateField<T1>(std::move(expression));                  \
         }                                                                      \
     }
 
@@ -67,14 +88,14 @@ private:                                                     \
                                               std::is_arithmetic<T2>::value>>  \
     inline auto operator OP(LHS_TYPE lhs, RHS_TYPE rhs) {                      \
         std::string expression = "(";                                          \
-        if (lhs.tableName_) expression += (*lhs.tableName_ + ".");             \
-        expression += lhs.fieldName_ + #OP;                                    \
-        if (rhs.tableName_) expression += (*rhs.tableName_ + ".");             \
-        expression += rhs.fieldName_ + ")";                                    \
+        lhs.AppendTo(expression);                                              \
+        expression += #OP;                                                     \
+        rhs.AppendTo(expression);                                              \
+        expression += ")";                                                     \
         if constexpr (std::is_convertible<T1, T2>::value) {                    \
-            return CalculateField<T2>(expression);                             \
+            return CalculateField<T2>(std::move(expression));                  \
         } else {                                                               \
-            return CalculateField<T1>(expression);                             \
+            return CalculateField<T1>(std::move(expression));                  \
         }                                                                      \
     }
 
@@ -84,6 +105,20 @@ private:                                                     \
         return RelationExpr(lhs, #OP, rhs);              \
     }
 
+#define STATIC_RELATION_OPERATOR_GENERATOR(OP, TAG, TEXT)                    \
+    struct TAG {                                                             \
+        constexpr static std::string_view SQL = TEXT;                        \
+    };                                                                       \
+    template <typename T>                                                    \
+    inline Compare<TAG, T> operator OP(const Column<T>& column, T value) {   \
+        return {column, std::move(value)};                                   \
+    }                                                                        \
+    template <typename T>                                                    \
+    inline CompareColumns<TAG, T, 2> operator OP(const Column<T>& lhs,       \
+                                                 const Column<T>& rhs) {     \
+        return CompareColumns<TAG, T, 2>({lhs, rhs});                        \
+    }
+
 #define NO_REFLECTIONED \
     "Please Inject the metainformation of your class by `REFLECTION` first"
 #define NO_SUCH_FIELD "No such a field"
@@ -91,6 +126,8 @@ private:                                                     \
 #define NULL_DESERIALIZE "Cannot deserialize NULL value to a non-nullable value"
 #define NOT_THE_SAME_TABLE "Field is not in the same table"
 #define BAD_COLUMN_COUNT "Bad Column Count"
+#define FULL_SCAN "Full scan of a large table"
+#define EXECUTOR_STOPPED "The executor is shut down"
 namespace tinyorm {
 /**
  * @brief Nullable is wrapper class.
@@ -130,18 +167,18 @@ public:
     }
     ~Nullable() = default;
 
-    Nullable<T> operator=(std::nullptr_t) {
+    Nullable<T>& operator=(std::nullptr_t) {
         value_ = std::nullopt;
         return *this;
     }
 
-    Nullable<T> operator=(const T& value) {
+    Nullable<T>& operator=(const T& value) {
         value_ = value;
         return *this;
     }
 
     template <std::size_t N>
-    Nullable<std::string> operator=(const char (&arr)[N]) {
+    Nullable<std::string>& operator=(const char (&arr)[N]) {
         if constexpr (1 == N) {
             value_ = std::optional<std::string>();
         } else {
@@ -196,24 +233,64 @@ namespace tinyorm_impl {
  */
 class ReflectionVisitor {
 private:
-    static std::vector<std::string> ExtractFieldName(std::string_view input) {
-        std::vector<std::string> ret;
-        std::string::size_type start = 0, comma = 0;
-        while (comma != std::string_view::npos) {
-            comma = input.find_first_of(',', start);
-            if (__builtin_expect(input[start] == ' ', 0)) {
-                ++start;
-            }
-            if (__builtin_expect(input[comma - 1] == ' ', 0)) {
-                ret.emplace_back(input.substr(start, comma - start - 1));
-            } else {
-                ret.emplace_back(input.substr(start, comma - start));
-            }
-            start = comma + 1;
+    //! Number of fields in the stringized field list of REFLECTION.
+    constexpr static size_t CountFields(std::string_view input) {
+        size_t count = 1;
+        for (char ch : input) count += (ch == ',');
+        return count;
+    }
+
+    //! Split the stringized field list of REFLECTION into trimmed names.
+    template <size_t N>
+    constexpr static std::array<std::string_view, N> ExtractFieldName(
+        std::string_view input) {
+        std::array<std::string_view, N> ret{};
+        for (auto& name : ret) {
+            auto comma = input.find(',');
+            name = input.substr(0, comma);
+            while (!name.empty() && name.front() == ' ') name.remove_prefix(1);
+            while (!name.empty() && name.back() == ' ') name.remove_suffix(1);
+            input.remove_prefix(comma == std::string_view::npos ? input.size()
+                                                                : comma + 1);
         }
         return ret;
     }
 
+    template <typename C>
+    constexpr static auto fieldNames_ =
+        ExtractFieldName<CountFields(C::__FieldNames)>(C::__FieldNames);
+
+    struct FirstField {
+        template <typename T, typename... Rest>
+        T& operator()(T& first, Rest&...) const;
+    };
+
+    constexpr static uint16_t NO_FIELD = UINT16_MAX;
+
+    /**
+     * @brief Uninitialized storage for a `C`, whose fields are only located.
+     * @details `C` is never constructed, so it needs no default constructor
+     * and none of its side effects happen.
+     */
+    template <typename C>
+    inline static const C& Probe() {
+        alignas(C) static const unsigned char storage[sizeof(C)] = {};
+        return *reinterpret_cast<const C*>(storage);
+    }
+
+    //! The index of the field of `C` at every byte offset, or NO_FIELD.
+    template <typename C>
+    inline static const std::vector<uint16_t>& FieldAt() {
+        static const auto fields = [] {
+            std::vector<uint16_t> ret(sizeof(C), NO_FIELD);
+            const auto& offsets = FieldOffsets(Probe<C>());
+            for (size_t idx = 0; idx < offsets.size(); ++idx)
+                ret[offsets[idx]] = static_cast<uint16_t>(idx);
+            return ret;
+        }();
+        return fields;
+    }
+
 public:
     template <typename T>
     class HasInjected {
@@ -229,16 +306,72 @@ public:
         static_assert(value, NO_REFLECTIONED);
     };
 
+    template <typename C>
+    constexpr static std::string_view TableName() {
+        return C::__TableName;
+    }
+
+    template <typename C>
+    struct PrimaryKeyOf {
+        using type =
+            std::decay_t<decltype(std::declval<C&>().__Apply(FirstField{}))>;
+    };
+
+    //! Type of the primary key of `C`, its first field.
+    template <typename C>
+    using PrimaryKey = typename PrimaryKeyOf<C>::type;
+
     template <typename C>
     inline static const std::string& TableName(const C&) {
         static const std::string tableName(C::__TableName);
         return tableName;
     }
 
+    /**
+     * @brief Field names of `C` in declaration order.
+     * @details The names are split at compile time into a
+     * `std::array<std::string_view, N>`, so they can be used in constant
+     * expressions.
+     */
+    template <typename C>
+    constexpr static const auto& FieldNames() {
+        return fieldNames_<C>;
+    }
+
+    template <typename C>
+    constexpr static const auto& FieldNames(const C&) {
+        return fieldNames_<C>;
+    }
+
+    /**
+     * @brief Byte offsets of the fields of `C` in declaration order.
+     * @details They are the same for every object, so they are measured on
+     * the first one handed in.
+     */
     template <typename C>
-    inline static const std::vector<std::string>& FieldNames(const C&) {
-        static const auto fieldNames = ExtractFieldName(C::__FieldNames);
-        return fieldNames;
+    inline static const auto& FieldOffsets(const C& obj) {
+        static const auto offsets = Visit(obj, [&obj](const auto&... args) {
+            auto base = reinterpret_cast<std::uintptr_t>(&obj);
+            return std::array<size_t, sizeof...(args)>{static_cast<size_t>(
+                reinterpret_cast<std::uintptr_t>(&args) - base)...};
+        });
+        return offsets;
+    }
+
+    /**
+     * @brief The name of the field `member` of `C`, and its table name.
+     * @details The field is found by its offset, see `FieldAt`.
+     */
+    template <typename C, typename T>
+    inline static std::pair<std::string_view, const std::string*> Member(
+        T C::*member) {
+        const auto& probe = Probe<C>();
+        const auto& fields = FieldAt<C>();
+        auto offset = static_cast<size_t>(
+            reinterpret_cast<std::uintptr_t>(&(probe.*member)) -
+            reinterpret_cast<std::uintptr_t>(&probe));
+        if (fields[offset] == NO_FIELD) throw std::runtime_error(NO_SUCH_FIELD);
+        return {fieldNames_<C>[fields[offset]], &TableName(probe)};
     }
     /**
      * @brief Vistor can iterate over the field names which defined in a class
@@ -253,6 +386,147 @@ public:
     }
 };
 
+/**
+ * @brief SQL text of the statements which only depend on the reflected type.
+ * @details Every text is generated at compile time from the REFLECTION
+ * metadata, once per type, and placeholders stand for all the values. The
+ * primary key is the first field.
+ */
+class CrudSql {
+private:
+    //! Sink measuring a generated text.
+    struct Length {
+        size_t size = 0;
+        constexpr Length& operator<<(std::string_view str) {
+            size += str.size();
+            return *this;
+        }
+    };
+
+    //! Sink storing a generated text of `N` characters.
+    template <size_t N>
+    struct Text {
+        char data[N + 1] = {};
+        size_t size = 0;
+        constexpr Text& operator<<(std::string_view str) {
+            for (char ch : str) data[size++] = ch;
+            return *this;
+        }
+    };
+
+    //! Run `Gen::Write` twice, to size the text and then to fill it in.
+    template <typename Gen>
+    struct Build {
+        constexpr static size_t size = [] {
+            Length len;
+            Gen::Write(len);
+            return len.size;
+        }();
+        constexpr static Text<size> text = [] {
+            Text<size> ret;
+            Gen::Write(ret);
+            return ret;
+        }();
+        constexpr static std::string_view view{text.data, size};
+    };
+
+    //! Write `names[first..]` joined by ",", each followed by `suffix`.
+    template <typename Out, typename Names>
+    constexpr static void _Columns(Out& out, const Names& names, size_t first,
+                                   std::string_view suffix) {
+        for (size_t idx = first; idx < names.size(); ++idx) {
+            if (idx != first) out << ",";
+            out << names[idx] << suffix;
+        }
+    }
+
+    template <typename C, bool WithPrimaryKey>
+    struct InsertGen {
+        template <typename Out>
+        constexpr static void Write(Out& out) {
+            constexpr const auto& names = ReflectionVisitor::FieldNames<C>();
+            constexpr size_t first = WithPrimaryKey ? 0 : 1;
+            out << "insert into " << ReflectionVisitor::TableName<C>() << "(";
+            _Columns(out, names, first, "");
+            out << ") values (";
+            for (size_t idx = first; idx < names.size(); ++idx)
+                out << (idx == first ? "?" : ",?");
+            out << ");";
+        }
+    };
+
+    template <typename C>
+    struct UpdateGen {
+        template <typename Out>
+        constexpr static void Write(Out& out) {
+            constexpr const auto& names = ReflectionVisitor::FieldNames<C>();
+            constexpr auto table = ReflectionVisitor::TableName<C>();
+            out << "update " << table << " set ";
+            _Columns(out, names, 1, "=?");
+            out << " where " << table << "." << names[0] << "=?;";
+        }
+    };
+
+    template <typename C>
+    struct DeleteGen {
+        template <typename Out>
+        constexpr static void Write(Out& out) {
+            out << "delete from " << ReflectionVisitor::TableName<C>()
+                << " where " << ReflectionVisitor::FieldNames<C>()[0] << "=?;";
+        }
+    };
+
+    template <typename C, bool In>
+    struct FindGen {
+        template <typename Out>
+        constexpr static void Write(Out& out) {
+            constexpr const auto& names = ReflectionVisitor::FieldNames<C>();
+            constexpr auto table = ReflectionVisitor::TableName<C>();
+            out << "select ";
+            _Columns(out, names, 0, "");
+            out << " from " << table << " where " << table << "." << names[0]
+                << (In ? " in (" : "=?;");
+        }
+    };
+
+public:
+    //! `insert into T(...) values (?,...);` of every field.
+    template <typename C>
+    constexpr static std::string_view Insert() {
+        return Build<InsertGen<C, true>>::view;
+    }
+
+    //! `insert into T(...) values (?,...);` of every field but the key.
+    template <typename C>
+    constexpr static std::string_view InsertWithoutKey() {
+        return Build<InsertGen<C, false>>::view;
+    }
+
+    //! `update T set ...=? where T.key=?;`, the key is bound last.
+    template <typename C>
+    constexpr static std::string_view Update() {
+        return Build<UpdateGen<C>>::view;
+    }
+
+    //! `delete from T where key=?;`
+    template <typename C>
+    constexpr static std::string_view Delete() {
+        return Build<DeleteGen<C>>::view;
+    }
+
+    //! `select ... from T where T.key=?;`
+    template <typename C>
+    constexpr static std::string_view Find() {
+        return Build<FindGen<C, false>>::view;
+    }
+
+    //! `select ... from T where T.key in (`, the placeholders are up to you.
+    template <typename C>
+    constexpr static std::string_view FindIn() {
+        return Build<FindGen<C, true>>::view;
+    }
+};
+
 /**
  * @brief Mapping C++ data types to SQL data types
  * @details TypeString will checking type string during compile time. It
@@ -279,6 +553,12 @@ struct TypeString {
 template <typename T>
 struct TypeString<tinyorm::Nullable<T>> : TypeString<T> {};
 
+/**
+ * @brief A value bound to a `?` placeholder of a SQL statement.
+ */
+using BoundValue = std::variant<std::nullptr_t, long long, double, std::string>;
+using BoundValues = std::vector<BoundValue>;
+
 class Serializer {
 public:
     template <typename T>
@@ -305,6 +585,38 @@ public:
         }
         return false;
     }
+
+    //! Inline a bound value as a SQL literal.
+    inline static void SerializeBound(std::ostream& os,
+                                      const BoundValue& value) {
+        std::visit(
+            [&os](const auto& val) {
+                if constexpr (std::is_same_v<std::decay_t<decltype(val)>,
+                                             std::nullptr_t>) {
+                    os << "null";
+                } else {
+                    Serialize(os, val);
+                }
+            },
+            value);
+    }
+
+    template <typename T>
+    inline static BoundValue ToBound(const T& value) {
+        if constexpr (std::is_same_v<T, std::string>) {
+            return value;
+        } else if constexpr (std::is_floating_point_v<T>) {
+            return static_cast<double>(value);
+        } else {
+            return static_cast<long long>(value);
+        }
+    }
+
+    template <typename T>
+    inline static BoundValue ToBound(const tinyorm::Nullable<T>& value) {
+        if (value.HasValue()) return ToBound(value.Value());
+        return nullptr;
+    }
 };
 
 class Deserializer {
@@ -344,6 +656,39 @@ public:
             property = nullptr;
         }
     }
+
+    /**
+     * @brief Decode the `col`-th column of the current row of `stmt`.
+     * @details The column is read with the native accessor matching the
+     * field type, so no text parsing is involved.
+     */
+    template <typename T>
+    inline static std::enable_if_t<TypeString<T>::type_string != nullptr, void>
+    Deserialize(T& property, sqlite3_stmt* stmt, int col) {
+        if (sqlite3_column_type(stmt, col) == SQLITE_NULL)
+            throw std::runtime_error{NULL_DESERIALIZE};
+        if constexpr (std::is_same_v<T, std::string>) {
+            auto text = reinterpret_cast<const char*>(
+                sqlite3_column_text(stmt, col));
+            property.assign(text, sqlite3_column_bytes(stmt, col));
+        } else if constexpr (std::is_floating_point_v<T>) {
+            property = static_cast<T>(sqlite3_column_double(stmt, col));
+        } else {
+            property = static_cast<T>(sqlite3_column_int64(stmt, col));
+        }
+    }
+
+    template <typename T>
+    inline static std::enable_if_t<TypeString<T>::type_string != nullptr, void>
+    Deserialize(tinyorm::Nullable<T>& property, sqlite3_stmt* stmt, int col) {
+        if (sqlite3_column_type(stmt, col) == SQLITE_NULL) {
+            property = nullptr;
+        } else {
+            T res;
+            Deserialize(res, stmt, col);
+            property = std::move(res);
+        }
+    }
 };
 
 namespace Expression {
@@ -351,17 +696,55 @@ namespace Expression {
 /**
  * @brief AssignmentExpr can serialize a C++ assignment expression, like
  * `name="phoenix"`, to a SQL expression,like name='phoenix'
+ * @details The assigned values are kept aside and bound to `?` placeholders
+ * by `ToSql()`, `ToString()` inlines them as SQL literals. The column names
+ * share one buffer, which `&&` on a temporary extends in place.
  */
 class AssignmentExpr {
 private:
-    std::string expr_;
+    std::string columns_;         //!< The column names, back to back
+    std::vector<uint32_t> ends_;  //!< End of every name in `columns_`
+    BoundValues values_;
+
+    template <typename Fn>
+    std::string Join(Fn&& fn) const {
+        std::ostringstream os;
+        uint32_t begin = 0;
+        for (size_t idx = 0; idx < ends_.size(); ++idx) {
+            if (idx) os << ",";
+            os.write(columns_.data() + begin, ends_[idx] - begin) << "=";
+            fn(os, values_[idx]);
+            begin = ends_[idx];
+        }
+        return os.str();
+    }
+
+    inline void Append(const AssignmentExpr& rhs) {
+        auto offset = static_cast<uint32_t>(columns_.size());
+        columns_ += rhs.columns_;
+        for (auto end : rhs.ends_) ends_.push_back(offset + end);
+        values_.insert(values_.end(), rhs.values_.begin(), rhs.values_.end());
+    }
 
 public:
-    AssignmentExpr(const std::string& op) : expr_(std::move(op)) {}
+    AssignmentExpr(std::string_view field, BoundValue value)
+        : columns_(field),
+          ends_{static_cast<uint32_t>(field.size())},
+          values_{std::move(value)} {}
     ~AssignmentExpr() = default;
-    const std::string& ToString() const { return expr_; }
-    inline AssignmentExpr operator&&(const AssignmentExpr& rhs) {
-        return AssignmentExpr{expr_ + "," + rhs.expr_};
+    std::string ToString() const { return Join(Serializer::SerializeBound); }
+    std::string ToSql() const {
+        return Join([](std::ostream& os, const BoundValue&) { os << "?"; });
+    }
+    inline const BoundValues& Values() const { return values_; }
+    inline AssignmentExpr operator&&(const AssignmentExpr& rhs) const& {
+        auto ret = *this;
+        ret.Append(rhs);
+        return ret;
+    }
+    inline AssignmentExpr operator&&(const AssignmentExpr& rhs) && {
+        Append(rhs);
+        return std::move(*this);
     }
 };
 
@@ -374,6 +757,11 @@ struct FieldBase {
     inline std::string ToString() {
         return std::string{(tableName_ ? *tableName_ : "") + fieldName_};
     }
+    //! Append the qualified name, e.g. `Student.Age`, to `out`.
+    inline void AppendTo(std::string& out) const {
+        if (tableName_) out.append(*tableName_) += ".";
+        out += fieldName_;
+    }
 };
 
 template <typename T>
@@ -381,9 +769,7 @@ struct Field : public FieldBase<T> {
     Field(const std::string& field, const std::string* table)
         : FieldBase<T>(field, table) {}
     inline AssignmentExpr operator=(T value) {
-        std::ostringstream os;
-        Serializer::Serialize(os << this->fieldName_ << "=", value);
-        return AssignmentExpr(os.str());
+        return AssignmentExpr(this->fieldName_, Serializer::ToBound(value));
     }
 };
 
@@ -392,12 +778,10 @@ struct NullableField : public Field<T> {
     NullableField(const std::string& field, const std::string* table)
         : Field<T>(std::move(field), table) {}
     inline AssignmentExpr operator=(T value) {
-        std::ostringstream os;
-        Serializer::Serialize(os << this->fieldName_ << "=", value);
-        return AssignmentExpr(os.str());
+        return AssignmentExpr(this->fieldName_, Serializer::ToBound(value));
     }
     inline AssignmentExpr operator=(std::nullptr_t) {
-        return AssignmentExpr{this->fieldName_ + "=null"};
+        return AssignmentExpr(this->fieldName_, nullptr);
     }
 };
 
@@ -444,62 +828,192 @@ CALCULATEFIELD_OPERATOR_FIELD_FIELD_GENERATOR(/, const FieldBase<T1>&,
 CALCULATEFIELD_OPERATOR_FIELD_FIELD_GENERATOR(%, const FieldBase<T1>&,
                                               const FieldBase<T2>&)
 
+/**
+ * @brief Contiguous storage of an expression tree.
+ * @details The nodes refer to each other and to their text by offsets, so
+ * one tree is appended to another as a block, without walking either of
+ * them. The text of a term is the qualified column followed by the operator,
+ * e.g. `Student.Age>`.
+ */
+class ExprArena {
+public:
+    using Index = uint32_t;
+
+    //! A column, followed by a `?` placeholder if `bound`.
+    Index Term(const std::string* table, const std::string& column,
+               std::string_view op, bool bound) {
+        auto offset = static_cast<uint32_t>(text_.size());
+        text_.append(column).append(op);
+        return Push({false, false, bound, 0, 0, offset,
+                     static_cast<uint32_t>(text_.size()) - offset, table});
+    }
+
+    //! `lhs op rhs`, in parentheses if `grouped`.
+    Index Binary(Index lhs, std::string_view op, Index rhs, bool grouped) {
+        auto offset = static_cast<uint32_t>(text_.size());
+        text_.append(op);
+        return Push({true, grouped, false, lhs, rhs, offset,
+                     static_cast<uint32_t>(op.size()), nullptr});
+    }
+
+    //! Append the nodes of `other`, returns the offset of their indices.
+    Index Append(const ExprArena& other) {
+        auto base = static_cast<Index>(nodes_.size());
+        auto offset = static_cast<uint32_t>(text_.size());
+        text_ += other.text_;
+        nodes_.reserve(nodes_.size() + other.nodes_.size());
+        for (auto node : other.nodes_) {
+            node.lhs += base;
+            node.rhs += base;
+            node.offset += offset;
+            nodes_.push_back(node);
+        }
+        return base;
+    }
+
+    /**
+     * @brief Render the tree under `root` to `out`, with the bound values
+     * taken in order from `value`.
+     * @details Without `qualified` the columns are rendered without their
+     * table, as index definitions require.
+     */
+    void Render(std::string& out, Index root,
+                BoundValues::const_iterator& value, bool inlineValues,
+                bool qualified = true) const {
+        const auto& node = nodes_[root];
+        std::string_view text(text_.data() + node.offset, node.size);
+        if (node.binary) {
+            if (node.grouped) out += "(";
+            Render(out, node.lhs, value, inlineValues, qualified);
+            out += text;
+            Render(out, node.rhs, value, inlineValues, qualified);
+            if (node.grouped) out += ")";
+            return;
+        }
+        if (node.table && qualified) out.append(*node.table) += ".";
+        out += text;
+        if (!node.bound) return;
+        if (inlineValues) {
+            std::ostringstream os;
+            Serializer::SerializeBound(os, *value);
+            out += os.str();
+        } else {
+            out += "?";
+        }
+        ++value;
+    }
+
+private:
+    struct Node {
+        bool binary;
+        bool grouped;
+        bool bound;
+        Index lhs;
+        Index rhs;
+        uint32_t offset;  //!< Text of the node in `text_`
+        uint32_t size;
+        const std::string* table;
+    };
+    std::vector<Node> nodes_;
+    std::string text_;
+
+    inline Index Push(const Node& node) {
+        nodes_.push_back(node);
+        return static_cast<Index>(nodes_.size() - 1);
+    }
+};
+
+/**
+ * @brief A relational expression, e.g. `Student.Age>? and Student.ID=?`.
+ * @details The tree lives in an ExprArena and is only rendered by `ToSql()`
+ * or `ToString()`. Combining a temporary with `&&` or `||` appends the right
+ * operand to its arena, so a chain of n terms is built in O(n). A named
+ * left operand is copied first, so a filter grown in a loop must be moved:
+ * `filter = std::move(filter) && term;` is O(1) per term, whereas
+ * `filter = filter && term;` copies the whole filter every time.
+ */
 class RelationExpr {
 public:
     /**
      * @brief Unary Relationship Expression Constructor
      */
     template <typename T>
-    RelationExpr(const FieldBase<T>& field, std::string op)
-        : exprs_{{field.fieldName_ + op, field.tableName_}} {}
+    RelationExpr(const FieldBase<T>& field, std::string_view op)
+        : root_(arena_.Term(field.tableName_, field.fieldName_, op, false)) {}
 
     /**
      * @brief Binary Relationship Expression Constructor
+     * @details The value is bound to a `?` placeholder, so expressions which
+     * differ only in their values share the same SQL text.
      */
     template <typename T>
-    RelationExpr(const FieldBase<T>& field, std::string op, T value) {
-        std::ostringstream os;
-        Serializer::Serialize(os << field.fieldName_ << op, value);
-        exprs_.emplace_back(os.str(), field.tableName_);
-    }
+    RelationExpr(const FieldBase<T>& field, std::string_view op, T value)
+        : root_(arena_.Term(field.tableName_, field.fieldName_, op, true)),
+          values_{Serializer::ToBound(value)} {}
 
     /**
      * @brief Binary Relationship Expression Constructor
      */
     template <typename T>
-    RelationExpr(const FieldBase<T>& lhs, std::string op,
-                 const FieldBase<T>& rhs)
-        : exprs_{{lhs.fieldName_, lhs.tableName_},
-                 {std::move(op), nullptr},
-                 {rhs.fieldName_, rhs.tableName_}} {}
+    RelationExpr(const FieldBase<T>& lhs, std::string_view op,
+                 const FieldBase<T>& rhs) {
+        auto left = arena_.Term(lhs.tableName_, lhs.fieldName_, "", false);
+        auto right = arena_.Term(rhs.tableName_, rhs.fieldName_, "", false);
+        root_ = arena_.Binary(left, op, right, false);
+    }
 
-    std::string ToString() const {
-        std::ostringstream os;
-        for (const auto& item : exprs_) {
-            if (item.second) os << *(item.second) << ".";
-            os << item.first;
-        }
-        return os.str();
+    //! SQL text with the values inlined as literals, e.g. for DDL.
+    std::string ToString(bool qualified = true) const {
+        std::string ret;
+        auto value = values_.cbegin();
+        arena_.Render(ret, root_, value, true, qualified);
+        return ret;
+    }
+
+    //! SQL text with `?` placeholders for the values.
+    std::string ToSql() const {
+        std::string ret;
+        AppendSql(ret);
+        return ret;
+    }
+
+    //! Append `ToSql()` to `out`.
+    inline void AppendSql(std::string& out) const {
+        auto value = values_.cbegin();
+        arena_.Render(out, root_, value, false);
+    }
+
+    inline const BoundValues& Values() const { return values_; }
+
+    //! Copies this expression, move a filter to append to it in place.
+    inline RelationExpr operator&&(const RelationExpr& rhs) const& {
+        return RelationExpr(*this).And_Or(rhs, " and ");
+    }
+
+    inline RelationExpr operator&&(const RelationExpr& rhs) && {
+        return std::move(*this).And_Or(rhs, " and ");
     }
 
-    inline RelationExpr operator&&(const RelationExpr& rhs) const {
-        return And_Or(rhs, " and ");
+    //! Copies this expression, see `operator&&`.
+    inline RelationExpr operator||(const RelationExpr& rhs) const& {
+        return RelationExpr(*this).And_Or(rhs, " or ");
     }
 
-    inline RelationExpr operator||(const RelationExpr& rhs) const {
-        return And_Or(rhs, " or ");
+    inline RelationExpr operator||(const RelationExpr& rhs) && {
+        return std::move(*this).And_Or(rhs, " or ");
     }
 
 private:
-    std::list<std::pair<std::string, const std::string*>> exprs_;
-    inline RelationExpr And_Or(const RelationExpr& rhs, std::string op) const {
-        auto ret = *this;
-        auto rightExprs = rhs.exprs_;
-        ret.exprs_.emplace_front("(", nullptr);
-        ret.exprs_.emplace_back(std::move(op), nullptr);
-        ret.exprs_.splice(ret.exprs_.cend(), std::move(rightExprs));
-        ret.exprs_.emplace_back(")", nullptr);
-        return ret;
+    ExprArena arena_;
+    ExprArena::Index root_ = 0;
+    BoundValues values_;
+
+    inline RelationExpr And_Or(const RelationExpr& rhs,
+                               std::string_view op) && {
+        auto base = arena_.Append(rhs.arena_);
+        root_ = arena_.Binary(root_, op, base + rhs.root_, true);
+        values_.insert(values_.end(), rhs.values_.begin(), rhs.values_.end());
+        return std::move(*this);
     }
 };
 
@@ -549,571 +1063,2577 @@ inline RelationExpr operator!=(const FieldBase<T>& lhs, std::nullptr_t) {
     return RelationExpr(lhs, " is not null");
 }
 
-//! Aggregate Function
-inline auto Count() { return AggregateField<size_t>("count (*)"); }
-
-template <typename T>
-inline auto Count(const FieldBase<T>& field) {
-    return AggregateField<T>("count", field);
-}
-
+/**
+ * @brief Expression templates for filters of a static shape.
+ * @details Comparing a Column, e.g. `field.Static(s.Age) > 3`, yields a
+ * typed node instead of a RelationExpr: the shape of the expression is in
+ * its type, and only the values are kept at runtime. `Shape()` renders the
+ * SQL of an expression type once, and hands the same text out while the
+ * columns are the same, so every run hits the same cached statement and
+ * just binds new values. A static expression converts to a RelationExpr
+ * wherever one is expected.
+ */
 template <typename T>
-inline auto Sum(const FieldBase<T>& field) {
-    return AggregateField<T>("sum", field);
-}
+struct Column {
+    const std::string* table;
+    std::string_view name;  //!< Points to the static names of REFLECTION
 
-template <typename T>
-inline auto Max(const FieldBase<T>& field) {
-    return AggregateField<T>("max", field);
-}
+    inline void AppendTo(std::string& out) const {
+        if (table) out.append(*table) += ".";
+        out += name;
+    }
+    inline Field<T> ToField() const {
+        return Field<T>(std::string(name), table);
+    }
+    inline AssignmentExpr operator=(T value) const {
+        return AssignmentExpr(name, Serializer::ToBound(value));
+    }
+};
 
+//! The value type of the column of a field of type `T`.
 template <typename T>
-inline auto Min(const FieldBase<T>& field) {
-    return AggregateField<T>("min", field);
-}
+struct ColumnOf {
+    using type = T;
+};
 
 template <typename T>
-inline auto Avg(const FieldBase<T>& field) {
-    return AggregateField<T>("avg", field);
-}
+struct ColumnOf<tinyorm::Nullable<T>> {
+    using type = T;
+};
 
-}  // namespace Expression
-}  // namespace tinyorm_impl
+template <typename E>
+struct StaticExpr {
+    std::string ToSql() const {
+        std::string ret;
+        Self().AppendSql(ret);
+        return ret;
+    }
+    BoundValues Values() const {
+        BoundValues ret;
+        ret.reserve(E::ARITY);
+        Self().AppendValues(ret);
+        return ret;
+    }
+    std::string ToString() const { return Self().ToRelation().ToString(); }
+    operator RelationExpr() const { return Self().ToRelation(); }
 
-namespace tinyorm {
+private:
+    inline const E& Self() const { return static_cast<const E&>(*this); }
+};
 
-class Sqlite3 {
-public:
-    Sqlite3(const std::string& db_name) {
-        if (sqlite3_open(db_name.c_str(), &db) != SQLITE_OK)
-            throw std::runtime_error(
-                std::string("SQL error: Can't open database '") +
-                sqlite3_errmsg(db) + "'");
-    }
-    ~Sqlite3() { sqlite3_close(db); }
-
-    void Execute(const std::string& cmd) {
-        char* zErrMsg = nullptr;
-        int rc = SQLITE_OK;
-        for (int i = 0; i < MAX_TRIAL; ++i) {
-            rc = sqlite3_exec(db, cmd.c_str(), 0, 0, &zErrMsg);
-            if (rc != SQLITE_BUSY) break;
-            std::this_thread::sleep_for(std::chrono::microseconds(20));
-        }
-        if (rc != SQLITE_OK) {
-            auto errStr =
-                std::string("SQL ERROR: '") + zErrMsg + "' at '" + cmd + "'";
-            sqlite3_free(zErrMsg);
-            throw std::runtime_error(errStr);
-        }
+template <typename E>
+using IsStaticExpr = std::is_base_of<StaticExpr<E>, E>;
+
+//! Identity of the columns of an expression, see `Shape()`.
+template <typename E>
+using ColumnKey = std::array<const void*, 2 * E::COLUMNS>;
+
+//! `column op ?`
+template <typename Op, typename T>
+struct Compare : StaticExpr<Compare<Op, T>> {
+    constexpr static size_t ARITY = 1;
+    constexpr static size_t COLUMNS = 1;
+    Column<T> column;
+    T value;
+
+    Compare(const Column<T>& col, T val)
+        : column(col), value(std::move(val)) {}
+    inline void AppendSql(std::string& out) const {
+        column.AppendTo(out);
+        out.append(Op::SQL) += "?";
+    }
+    inline void AppendValues(BoundValues& out) const {
+        out.push_back(Serializer::ToBound(value));
+    }
+    template <typename Key>
+    inline void FillKey(Key& key, size_t& idx) const {
+        key[idx++] = column.table;
+        key[idx++] = column.name.data();
     }
+    inline RelationExpr ToRelation() const {
+        return RelationExpr(column.ToField(), Op::SQL, value);
+    }
+};
 
-    void ExecuteCallback(const std::string& cmd,
-                         std::function<void(int, char**)> callback) {
-        char* zErrMsg = nullptr;
-        int rc = SQLITE_OK;
-        auto callbackParam = std::make_pair(&callback, std::string{});
-
-        for (size_t i = 0; i < MAX_TRIAL; ++i) {
-            rc = sqlite3_exec(db, cmd.c_str(), CallbackWrapper, &callbackParam,
-                              &zErrMsg);
-            if (rc != SQLITE_BUSY) break;
-            std::this_thread::sleep_for(std::chrono::microseconds(20));
-        }
-        if (rc == SQLITE_ABORT) {
-            auto errStr =
-                "SQL error: '" + callbackParam.second + "' at '" + cmd + "'";
-            sqlite3_free(zErrMsg);
-            throw std::runtime_error(errStr);
-        } else if (rc != SQLITE_OK) {
-            auto errStr =
-                std::string("SQL error: '") + zErrMsg + "' at '" + cmd + "'";
-            sqlite3_free(zErrMsg);
-            throw std::runtime_error(errStr);
+//! `column op column`, or `column is [not] null` without the right column.
+template <typename Op, typename T, size_t Columns>
+struct CompareColumns : StaticExpr<CompareColumns<Op, T, Columns>> {
+    constexpr static size_t ARITY = 0;
+    constexpr static size_t COLUMNS = Columns;
+    std::array<Column<T>, Columns> columns;
+
+    explicit CompareColumns(std::array<Column<T>, Columns> cols)
+        : columns(cols) {}
+    inline void AppendSql(std::string& out) const {
+        columns[0].AppendTo(out);
+        out += Op::SQL;
+        if constexpr (Columns == 2) columns[1].AppendTo(out);
+    }
+    inline void AppendValues(BoundValues&) const {}
+    template <typename Key>
+    inline void FillKey(Key& key, size_t& idx) const {
+        for (const auto& column : columns) {
+            key[idx++] = column.table;
+            key[idx++] = column.name.data();
         }
     }
+    inline RelationExpr ToRelation() const {
+        if constexpr (Columns == 2)
+            return RelationExpr(columns[0].ToField(), Op::SQL,
+                                columns[1].ToField());
+        else
+            return RelationExpr(columns[0].ToField(), Op::SQL);
+    }
+};
 
-private:
-    sqlite3* db;
-    constexpr static size_t MAX_TRIAL = 16;
-    static int CallbackWrapper(void* cbParam, int argc, char** argv, char**) {
-        auto pParam = static_cast<
-            std::pair<std::function<void(int, char**)>*, std::string>*>(
-            cbParam);
-        try {
-            pParam->first->operator()(argc, argv);
-            return 0;
-        } catch (const std::exception& ex) {
-            pParam->second = ex.what();
-            return 1;
-        }
+//! `(lhs op rhs)`, with `op` one of `and`, `or`.
+template <typename Op, typename L, typename R>
+struct Logical : StaticExpr<Logical<Op, L, R>> {
+    constexpr static size_t ARITY = L::ARITY + R::ARITY;
+    constexpr static size_t COLUMNS = L::COLUMNS + R::COLUMNS;
+    L lhs;
+    R rhs;
+
+    Logical(L left, R right) : lhs(std::move(left)), rhs(std::move(right)) {}
+    inline void AppendSql(std::string& out) const {
+        out += "(";
+        lhs.AppendSql(out);
+        out += Op::SQL;
+        rhs.AppendSql(out);
+        out += ")";
+    }
+    inline void AppendValues(BoundValues& out) const {
+        lhs.AppendValues(out);
+        rhs.AppendValues(out);
+    }
+    template <typename Key>
+    inline void FillKey(Key& key, size_t& idx) const {
+        lhs.FillKey(key, idx);
+        rhs.FillKey(key, idx);
+    }
+    inline RelationExpr ToRelation() const {
+        if constexpr (Op::SQL == std::string_view(" and "))
+            return lhs.ToRelation() && rhs.ToRelation();
+        else
+            return lhs.ToRelation() || rhs.ToRelation();
     }
 };
 
 /**
- * @brief Extract fields from the given object for the JOIN operation.
+ * @brief The SQL of a static expression, with `?` for its values.
+ * @details The text is rendered once per expression type and thread, and
+ * only again when the same type is used on other columns.
  */
-class FieldExtractor {
-private:
-    using pair_type = std::pair<const std::string&, const std::string&>;
-    template <typename C>
-    using HasInjected = tinyorm_impl::ReflectionVisitor::HasInjected<C>;
-    std::unordered_map<const void*, pair_type> fieldCache_;
+template <typename E>
+std::shared_ptr<const std::string> Shape(const E& expr) {
+    thread_local ColumnKey<E> cachedKey{};
+    thread_local std::shared_ptr<const std::string> shape;
+    ColumnKey<E> key;
+    size_t idx = 0;
+    expr.FillKey(key, idx);
+    if (!shape || key != cachedKey) {
+        std::string sql;
+        expr.AppendSql(sql);
+        shape = std::make_shared<const std::string>(std::move(sql));
+        cachedKey = key;
+    }
+    return shape;
+}
+
+STATIC_RELATION_OPERATOR_GENERATOR(==, Equal, "=")
+STATIC_RELATION_OPERATOR_GENERATOR(!=, NotEqual, "!=")
+STATIC_RELATION_OPERATOR_GENERATOR(<, Less, "<")
+STATIC_RELATION_OPERATOR_GENERATOR(<=, LessEqual, "<=")
+STATIC_RELATION_OPERATOR_GENERATOR(>, Greater, ">")
+STATIC_RELATION_OPERATOR_GENERATOR(>=, GreaterEqual, ">=")
+
+struct Like {
+    constexpr static std::string_view SQL = " like ";
+};
+struct NotLike {
+    constexpr static std::string_view SQL = " not like ";
+};
+struct IsNull {
+    constexpr static std::string_view SQL = " is null";
+};
+struct IsNotNull {
+    constexpr static std::string_view SQL = " is not null";
+};
+struct And {
+    constexpr static std::string_view SQL = " and ";
+};
+struct Or {
+    constexpr static std::string_view SQL = " or ";
+};
+
+inline Compare<Like, std::string> operator&(const Column<std::string>& column,
+                                            const std::string& value) {
+    return {column, value};
+}
+
+inline Compare<NotLike, std::string> operator|(
+    const Column<std::string>& column, const std::string& value) {
+    return {column, value};
+}
+
+template <typename T>
+inline CompareColumns<IsNull, T, 1> operator==(const Column<T>& column,
+                                               std::nullptr_t) {
+    return CompareColumns<IsNull, T, 1>({column});
+}
+
+template <typename T>
+inline CompareColumns<IsNotNull, T, 1> operator!=(const Column<T>& column,
+                                                  std::nullptr_t) {
+    return CompareColumns<IsNotNull, T, 1>({column});
+}
+
+template <typename L, typename R,
+          class Enable = std::enable_if_t<IsStaticExpr<L>::value &&
+                                          IsStaticExpr<R>::value>>
+inline Logical<And, L, R> operator&&(const L& lhs, const R& rhs) {
+    return {lhs, rhs};
+}
+
+template <typename L, typename R,
+          class Enable = std::enable_if_t<IsStaticExpr<L>::value &&
+                                          IsStaticExpr<R>::value>>
+inline Logical<Or, L, R> operator||(const L& lhs, const R& rhs) {
+    return {lhs, rhs};
+}
+
+//! Aggregate Function
+inline auto Count() { return AggregateField<size_t>("count (*)"); }
+
+template <typename T>
+inline auto Count(const FieldBase<T>& field) {
+    return AggregateField<T>("count", field);
+}
+
+template <typename T>
+inline auto Sum(const FieldBase<T>& field) {
+    return AggregateField<T>("sum", field);
+}
+
+template <typename T>
+inline auto Max(const FieldBase<T>& field) {
+    return AggregateField<T>("max", field);
+}
+
+template <typename T>
+inline auto Min(const FieldBase<T>& field) {
+    return AggregateField<T>("min", field);
+}
+
+template <typename T>
+inline auto Avg(const FieldBase<T>& field) {
+    return AggregateField<T>("avg", field);
+}
+
+template <typename T>
+inline auto Count(const Column<T>& column) {
+    return Count(column.ToField());
+}
+
+template <typename T>
+inline auto Sum(const Column<T>& column) {
+    return Sum(column.ToField());
+}
+
+template <typename T>
+inline auto Max(const Column<T>& column) {
+    return Max(column.ToField());
+}
+
+template <typename T>
+inline auto Min(const Column<T>& column) {
+    return Min(column.ToField());
+}
+
+template <typename T>
+inline auto Avg(const Column<T>& column) {
+    return Avg(column.ToField());
+}
+
+}  // namespace Expression
+}  // namespace tinyorm_impl
+
+namespace tinyorm {
+
+/**
+ * @brief Counters of the prepared statement cache owned by a Sqlite3 handle.
+ */
+struct StatementCacheStats {
+    size_t hits = 0;       //!< Statement reused from the cache.
+    size_t misses = 0;     //!< Statement compiled by sqlite3_prepare_v2.
+    size_t evictions = 0;  //!< Least recently used statement finalized.
+};
+
+/**
+ * @brief How a Sqlite3 connection waits for a database locked by another
+ * connection.
+ * @details Every wait doubles the delay of the previous one, from
+ * `initialDelay` up to `maxDelay`, until `deadline` has passed since the
+ * lock was first hit. With `jitter` a delay is drawn from [delay/2, delay]
+ * so that competing connections don't retry in lockstep.
+ */
+struct BusyPolicy {
+    enum class Mode {
+        Backoff,  //!< Step retries SQLITE_BUSY until a row was delivered.
+        Handler,  //!< SQLite waits through sqlite3_busy_handler.
+    };
+
+    Mode mode = Mode::Backoff;
+    std::chrono::microseconds initialDelay{20};
+    std::chrono::microseconds maxDelay{10000};
+    std::chrono::microseconds deadline{1000000};
+    bool jitter = true;
+};
+
+/**
+ * @brief Counters of the waits on locked databases.
+ */
+struct BusyWaitStats {
+    size_t events = 0;    //!< Times a lock held by another connection was hit.
+    size_t retries = 0;   //!< Waits before trying again.
+    size_t timeouts = 0;  //!< Waits given up at the deadline.
+    std::chrono::microseconds waited{0};  //!< Time spent sleeping.
+
+    BusyWaitStats& operator+=(const BusyWaitStats& other) {
+        events += other.events;
+        retries += other.retries;
+        timeouts += other.timeouts;
+        waited += other.waited;
+        return *this;
+    }
+};
+
+/**
+ * @brief Executions, rows and latencies of one statement shape, i.e. one
+ * SQL text with `?` placeholders.
+ * @details The latency of an execution is measured by SQLite from its
+ * first step to its reset, so it includes the work of the caller between
+ * two rows, e.g. decoding them.
+ */
+struct StatementProfile {
+    constexpr static size_t BUCKETS = 40;
+
+    size_t count = 0;  //!< Executions.
+    size_t rows = 0;   //!< Rows returned.
+    std::chrono::nanoseconds total{0};
+    std::chrono::nanoseconds max{0};
+    //! `histogram[i]` counts the executions faster than 2^(i+1) ns, and not
+    //! in a lower bucket. The last bucket takes all the slower ones.
+    std::array<size_t, BUCKETS> histogram{};
+
+    void Add(std::chrono::nanoseconds elapsed, size_t rowCount) {
+        ++count;
+        rows += rowCount;
+        total += elapsed;
+        max = std::max(max, elapsed);
+        size_t bucket = 0;
+        for (auto ns = elapsed.count(); ns > 1 && bucket + 1 < BUCKETS;
+             ns >>= 1)
+            ++bucket;
+        ++histogram[bucket];
+    }
+
+    /**
+     * @brief The latency under which a `fraction` of the executions ran,
+     * e.g. 0.99 for p99.
+     * @details Rounded up to the bound of its histogram bucket, but never
+     * above `max`.
+     */
+    std::chrono::nanoseconds Percentile(double fraction) const {
+        if (count == 0) return std::chrono::nanoseconds(0);
+        auto rank = static_cast<size_t>(fraction * count);
+        size_t seen = 0;
+        for (size_t bucket = 0; bucket < BUCKETS; ++bucket) {
+            seen += histogram[bucket];
+            if (seen > rank || seen == count)
+                return std::min(max,
+                                std::chrono::nanoseconds(2LL << bucket));
+        }
+        return max;
+    }
+
+    StatementProfile& operator+=(const StatementProfile& other) {
+        count += other.count;
+        rows += other.rows;
+        total += other.total;
+        max = std::max(max, other.max);
+        for (size_t bucket = 0; bucket < BUCKETS; ++bucket)
+            histogram[bucket] += other.histogram[bucket];
+        return *this;
+    }
+};
+
+/**
+ * @brief A snapshot of the profile of a connection, see
+ * Sqlite3::SetProfiling.
+ */
+struct ProfileStats {
+    //! Keyed by the SQL text of the statements.
+    std::unordered_map<std::string, StatementProfile> statements;
+    std::chrono::nanoseconds build{0};    //!< Rendering queries to SQL.
+    std::chrono::nanoseconds prepare{0};  //!< Compiling statements.
+    std::chrono::nanoseconds step{0};     //!< Executions, as measured above.
+    std::chrono::nanoseconds decode{0};   //!< Decoding rows into objects.
+
+    ProfileStats& operator+=(const ProfileStats& other) {
+        for (const auto& [sql, profile] : other.statements)
+            statements[sql] += profile;
+        build += other.build;
+        prepare += other.prepare;
+        step += other.step;
+        decode += other.decode;
+        return *this;
+    }
+};
+
+/**
+ * @brief Pragmas applied to every connection opened by a Sqlite3 backend.
+ * @details Unset options keep the SQLite defaults. Sqlite3::Options() reads
+ * back the effective values, e.g. an in-memory database reports
+ * JournalMode::Memory even if JournalMode::Wal was requested.
+ */
+struct Sqlite3Options {
+    enum class JournalMode { Delete, Truncate, Persist, Memory, Wal, Off };
+    enum class Synchronous { Off, Normal, Full, Extra };
+    enum class TempStore { Default, File, Memory };
+
+    std::optional<JournalMode> journalMode;
+    std::optional<Synchronous> synchronous;
+    std::optional<long long> cacheSize;  //!< Pages, or KiB if negative.
+    std::optional<long long> mmapSize;   //!< Bytes, 0 disables mmap.
+    std::optional<TempStore> tempStore;
+    std::optional<int> pageSize;     //!< Power of two in [512, 65536].
+    std::optional<int> busyTimeout;  //!< Milliseconds.
+    //! Replaces `busyTimeout` with BusyPolicy::Mode::Handler.
+    std::optional<BusyPolicy> busyPolicy;
+};
+
+/**
+ * @brief Sqlite3 backend
+ * @details Every single-statement SQL text is compiled once and kept in a
+ * bounded LRU cache of `sqlite3_stmt` handles keyed by the SQL text, so that
+ * repeated calls skip parsing and planning. Multi-statement scripts are run
+ * statement by statement and are never cached.
+ */
+class Sqlite3 {
+private:
+    struct CacheEntry {
+        std::string sql;
+        sqlite3_stmt* stmt;
+        bool inUse;
+    };
+    using CacheList = std::list<CacheEntry>;
+
+public:
+    /**
+     * @brief A prepared statement leased from the statement cache.
+     * @details The statement is reset and handed back to the cache when the
+     * lease is destroyed. A statement which is not owned by the cache (e.g.
+     * the same SQL text is already leased) is finalized instead.
+     */
+    class Statement {
+    public:
+        Statement(Statement&& other) noexcept
+            : owner_(other.owner_),
+              entry_(other.entry_),
+              stmt_(other.stmt_),
+              stepped_(other.stepped_) {
+            other.entry_ = nullptr;
+            other.stmt_ = nullptr;
+        }
+        Statement& operator=(Statement&& other) noexcept {
+            if (this != &other) {
+                Release();
+                std::swap(owner_, other.owner_);
+                std::swap(entry_, other.entry_);
+                std::swap(stmt_, other.stmt_);
+                std::swap(stepped_, other.stepped_);
+            }
+            return *this;
+        }
+        Statement(const Statement&) = delete;
+        Statement& operator=(const Statement&) = delete;
+        ~Statement() { Release(); }
+
+        inline sqlite3_stmt* Get() const { return stmt_; }
+
+        /**
+         * @brief Bind a value to the `idx`-th placeholder (1-based).
+         * @details Text is bound without copying, it must outlive the
+         * execution of the statement.
+         */
+        void Bind(int idx, const tinyorm_impl::BoundValue& value) {
+            int rc = std::visit(
+                [this, idx](const auto& val) {
+                    using T = std::decay_t<decltype(val)>;
+                    if constexpr (std::is_same_v<T, std::nullptr_t>) {
+                        return sqlite3_bind_null(stmt_, idx);
+                    } else if constexpr (std::is_same_v<T, long long>) {
+                        return sqlite3_bind_int64(stmt_, idx, val);
+                    } else if constexpr (std::is_same_v<T, double>) {
+                        return sqlite3_bind_double(stmt_, idx, val);
+                    } else {
+                        return sqlite3_bind_text(stmt_, idx, val.data(),
+                                                 static_cast<int>(val.size()),
+                                                 SQLITE_STATIC);
+                    }
+                },
+                value);
+            if (rc != SQLITE_OK)
+                _Throw(sqlite3_db_handle(stmt_), sqlite3_sql(stmt_));
+        }
+
+        void Bind(const tinyorm_impl::BoundValues& values) {
+            int idx = 0;
+            for (const auto& value : values) Bind(++idx, value);
+        }
+
+        /**
+         * @brief Bind a field of a reflected object without converting it
+         * to a BoundValue first.
+         */
+        template <typename T>
+        void Bind(int idx, const T& value) {
+            int rc;
+            if constexpr (std::is_same_v<T, std::string>) {
+                rc = sqlite3_bind_text(stmt_, idx, value.data(),
+                                       static_cast<int>(value.size()),
+                                       SQLITE_STATIC);
+            } else if constexpr (std::is_floating_point_v<T>) {
+                rc = sqlite3_bind_double(stmt_, idx, value);
+            } else {
+                static_assert(tinyorm_impl::TypeString<T>::type_string !=
+                              nullptr);
+                rc = sqlite3_bind_int64(stmt_, idx,
+                                        static_cast<sqlite3_int64>(value));
+            }
+            if (rc != SQLITE_OK)
+                _Throw(sqlite3_db_handle(stmt_), sqlite3_sql(stmt_));
+        }
+
+        template <typename T>
+        void Bind(int idx, const Nullable<T>& value) {
+            if (value.HasValue())
+                Bind(idx, value.Value());
+            else
+                Bind(idx, tinyorm_impl::BoundValue{nullptr});
+        }
+
+        //! Rewind the statement for another execution, keeping bindings.
+        void Reset() {
+            sqlite3_reset(stmt_);
+            stepped_ = false;
+        }
+
+        /**
+         * @brief Step to the next row.
+         * @return true if a row is available, false once the statement is
+         * done.
+         * @details With BusyPolicy::Mode::Backoff, SQLITE_BUSY is retried as
+         * long as no row has been delivered yet.
+         */
+        bool Step() {
+            if (stmt_ == nullptr) return false;
+            for (int trial = 0;; ++trial) {
+                int rc = sqlite3_step(stmt_);
+                if (rc == SQLITE_ROW) {
+                    stepped_ = true;
+                    return true;
+                }
+                if (rc == SQLITE_DONE) return false;
+                if (rc != SQLITE_BUSY || stepped_ ||
+                    owner_->busyPolicy_.mode != BusyPolicy::Mode::Backoff ||
+                    !owner_->_Backoff(trial))
+                    _Throw(sqlite3_db_handle(stmt_), sqlite3_sql(stmt_));
+                sqlite3_reset(stmt_);
+            }
+        }
+
+    private:
+        friend class Sqlite3;
+        Sqlite3* owner_;
+        CacheEntry* entry_;
+        sqlite3_stmt* stmt_;
+        bool stepped_ = false;
+
+        Statement(Sqlite3* owner, CacheEntry* entry, sqlite3_stmt* stmt)
+            : owner_(owner), entry_(entry), stmt_(stmt) {}
+
+        void Release() {
+            if (stmt_ == nullptr) return;
+            sqlite3_reset(stmt_);
+            sqlite3_clear_bindings(stmt_);
+            if (entry_)
+                entry_->inUse = false;
+            else
+                sqlite3_finalize(stmt_);
+            entry_ = nullptr;
+            stmt_ = nullptr;
+            stepped_ = false;
+        }
+    };
+
+    Sqlite3(const std::string& db_name,
+            size_t cacheCapacity = DEFAULT_CACHE_CAPACITY)
+        : capacity_(cacheCapacity) {
+        if (sqlite3_open(db_name.c_str(), &db) != SQLITE_OK) {
+            auto errStr = std::string("SQL error: Can't open database '") +
+                          sqlite3_errmsg(db) + "'";
+            sqlite3_close(db);
+            throw std::runtime_error(errStr);
+        }
+        sqlite3_db_config(db, SQLITE_DBCONFIG_ENABLE_FKEY, 1, nullptr);
+    }
+    Sqlite3(const std::string& db_name, const Sqlite3Options& options,
+            size_t cacheCapacity = DEFAULT_CACHE_CAPACITY)
+        : Sqlite3(db_name, cacheCapacity) {
+        _Apply(options);
+    }
+    Sqlite3(const Sqlite3&) = delete;
+    Sqlite3& operator=(const Sqlite3&) = delete;
+    ~Sqlite3() {
+        if (profiling_) sqlite3_trace_v2(db, 0, nullptr, nullptr);
+        for (auto& entry : cache_) sqlite3_finalize(entry.stmt);
+        sqlite3_close(db);
+    }
+
+    /**
+     * @brief Lease a compiled statement for a single SQL statement.
+     */
+    Statement Prepare(std::string_view sql) {
+        const char* tail = nullptr;
+        auto stmt = _Checkout(sql, &tail);
+        if (!_IsBlank(tail, sql.data() + sql.size()))
+            throw std::runtime_error("SQL error: 'multiple statements' at '" +
+                                     std::string(sql) + "'");
+        return stmt;
+    }
+
+    void Execute(const std::string& cmd) { _Run(cmd, {}, nullptr); }
+
+    void Execute(const std::string& cmd,
+                 const tinyorm_impl::BoundValues& params) {
+        _Run(cmd, params, nullptr);
+    }
+
+    void ExecuteCallback(const std::string& cmd,
+                         std::function<void(int, char**)> callback) {
+        ExecuteCallback(cmd, {}, std::move(callback));
+    }
+
+    //! Deliver every row as text, like the callback of `sqlite3_exec`.
+    void ExecuteCallback(const std::string& cmd,
+                         const tinyorm_impl::BoundValues& params,
+                         std::function<void(int, char**)> callback) {
+        std::vector<char*> argv;
+        RowCallback onRow = [&callback, &argv](sqlite3_stmt* stmt) {
+            int argc = sqlite3_column_count(stmt);
+            argv.resize(argc);
+            for (int i = 0; i < argc; ++i)
+                argv[i] = reinterpret_cast<char*>(
+                    const_cast<unsigned char*>(sqlite3_column_text(stmt, i)));
+            callback(argc, argv.data());
+        };
+        _Run(cmd, params, &onRow);
+    }
+
+    //! Deliver every row as the stepped statement for typed column access.
+    void ExecuteCallback(const std::string& cmd,
+                         const tinyorm_impl::BoundValues& params,
+                         std::function<void(sqlite3_stmt*)> callback) {
+        _Run(cmd, params, &callback);
+    }
+
+    //! Maximum number of `?` placeholders in one statement.
+    inline int MaxVariableNumber() const {
+        return sqlite3_limit(db, SQLITE_LIMIT_VARIABLE_NUMBER, -1);
+    }
+
+    //! The effective value of every option on this connection.
+    Sqlite3Options Options() {
+        using JournalMode = Sqlite3Options::JournalMode;
+        using Synchronous = Sqlite3Options::Synchronous;
+        using TempStore = Sqlite3Options::TempStore;
+        static constexpr const char* JOURNAL_MODES[] = {
+            "delete", "truncate", "persist", "memory", "wal", "off"};
+        Sqlite3Options options;
+        auto mode = _QueryPragma("journal_mode");
+        for (size_t idx = 0; idx < std::size(JOURNAL_MODES); ++idx) {
+            if (mode == JOURNAL_MODES[idx])
+                options.journalMode = static_cast<JournalMode>(idx);
+        }
+        // A pragma disabled at compile time reports no value, i.e. 0.
+        auto number = [this](const std::string& name) {
+            return std::atoll(_QueryPragma(name).c_str());
+        };
+        options.synchronous = static_cast<Synchronous>(number("synchronous"));
+        options.cacheSize = number("cache_size");
+        options.mmapSize = number("mmap_size");
+        options.tempStore = static_cast<TempStore>(number("temp_store"));
+        options.pageSize = static_cast<int>(number("page_size"));
+        options.busyTimeout = static_cast<int>(number("busy_timeout"));
+        return options;
+    }
+
+    /**
+     * @brief Change how the connection waits for locked databases.
+     * @details BusyPolicy::Mode::Handler registers a handler through
+     * `sqlite3_busy_handler`, which replaces a `busy_timeout`. It is also
+     * consulted by locks taken after the first row, e.g. at commit.
+     */
+    void SetBusyPolicy(const BusyPolicy& policy) {
+        busyPolicy_ = policy;
+        if (policy.mode == BusyPolicy::Mode::Handler)
+            sqlite3_busy_handler(db, &Sqlite3::_OnBusy, this);
+        else
+            sqlite3_busy_handler(db, nullptr, nullptr);
+    }
+    inline const BusyPolicy& GetBusyPolicy() const { return busyPolicy_; }
+
+    BusyWaitStats BusyStats() const {
+        BusyWaitStats stats;
+        stats.events = busyEvents_;
+        stats.retries = busyRetries_;
+        stats.timeouts = busyTimeouts_;
+        stats.waited = std::chrono::microseconds(busyWaited_);
+        return stats;
+    }
+
+    //! Whether a transaction or savepoint is open on this connection.
+    inline bool InTransaction() const { return !sqlite3_get_autocommit(db); }
+
+    inline const StatementCacheStats& CacheStats() const { return stats_; }
+    inline size_t CacheSize() const { return index_.size(); }
+    inline size_t CacheCapacity() const { return capacity_; }
+
+    /**
+     * @brief Collect a ProfileStats of the statements run from now on.
+     * @details Executions and rows are traced through `sqlite3_trace_v2`,
+     * the compile time is measured here and the ORM adds the time it spends
+     * building SQL and decoding rows. Turning profiling off keeps the
+     * collected profile.
+     */
+    void SetProfiling(bool enabled) {
+        profiling_ = enabled;
+        if (enabled)
+            sqlite3_trace_v2(db, SQLITE_TRACE_PROFILE | SQLITE_TRACE_ROW,
+                             &Sqlite3::_OnTrace, this);
+        else
+            sqlite3_trace_v2(db, 0, nullptr, nullptr);
+    }
+    inline bool Profiling() const { return profiling_; }
+
+    ProfileStats Profile() const {
+        std::lock_guard<std::mutex> lock(profileMutex_);
+        return profile_;
+    }
+
+    void ResetProfile() {
+        std::lock_guard<std::mutex> lock(profileMutex_);
+        profile_ = ProfileStats();
+    }
+
+    //! Add `elapsed` to a phase of the profile, e.g. &ProfileStats::decode.
+    void AddProfileTime(std::chrono::nanoseconds ProfileStats::*phase,
+                        std::chrono::nanoseconds elapsed) {
+        std::lock_guard<std::mutex> lock(profileMutex_);
+        profile_.*phase += elapsed;
+    }
+
+private:
+    using RowCallback = std::function<void(sqlite3_stmt*)>;
+    sqlite3* db;
+    size_t capacity_;
+    CacheList cache_;  //!< Most recently used statement first.
+    std::unordered_map<std::string_view, CacheList::iterator> index_;
+    StatementCacheStats stats_;
+    BusyPolicy busyPolicy_;
+    std::chrono::steady_clock::time_point busySince_;
+    // Atomic, a pool reads them while the connection is used elsewhere.
+    std::atomic<size_t> busyEvents_{0};
+    std::atomic<size_t> busyRetries_{0};
+    std::atomic<size_t> busyTimeouts_{0};
+    std::atomic<long long> busyWaited_{0};  //!< Microseconds.
+    std::atomic<bool> profiling_{false};
+    // Locked, a pool reads the profile while the connection is used.
+    mutable std::mutex profileMutex_;
+    ProfileStats profile_;
+    //! Rows stepped by the statements not reset yet.
+    std::unordered_map<sqlite3_stmt*, size_t> pendingRows_;
+    constexpr static size_t DEFAULT_CACHE_CAPACITY = 64;
+
+    static int _OnTrace(unsigned type, void* ctx, void* stmt, void* data) {
+        auto self = static_cast<Sqlite3*>(ctx);
+        auto key = static_cast<sqlite3_stmt*>(stmt);
+        if (type == SQLITE_TRACE_ROW) {
+            ++self->pendingRows_[key];
+            return 0;
+        }
+        std::chrono::nanoseconds elapsed(*static_cast<sqlite3_int64*>(data));
+        size_t rows = 0;
+        auto it = self->pendingRows_.find(key);
+        if (it != self->pendingRows_.end()) {
+            rows = it->second;
+            self->pendingRows_.erase(it);
+        }
+        std::lock_guard<std::mutex> lock(self->profileMutex_);
+        self->profile_.statements[sqlite3_sql(key)].Add(elapsed, rows);
+        self->profile_.step += elapsed;
+        return 0;
+    }
+
+    /**
+     * @brief Sleep before the `count`-th retry on a locked database.
+     * @return false once the deadline would be exceeded.
+     */
+    bool _Backoff(int count) {
+        using namespace std::chrono;
+        thread_local std::minstd_rand random{std::random_device{}()};
+        auto now = steady_clock::now();
+        if (count == 0) {
+            busySince_ = now;
+            ++busyEvents_;
+        }
+        auto delay = busyPolicy_.initialDelay;
+        for (int i = 0; i < count && delay < busyPolicy_.maxDelay; ++i)
+            delay *= 2;
+        delay = std::min(delay, busyPolicy_.maxDelay);
+        if (busyPolicy_.jitter && delay.count() > 1)
+            delay = microseconds(std::uniform_int_distribution<long long>(
+                delay.count() / 2, delay.count())(random));
+        if (now - busySince_ + delay > busyPolicy_.deadline) {
+            ++busyTimeouts_;
+            return false;
+        }
+        std::this_thread::sleep_for(delay);
+        ++busyRetries_;
+        busyWaited_ +=
+            duration_cast<microseconds>(steady_clock::now() - now).count();
+        return true;
+    }
+
+    static int _OnBusy(void* self, int count) {
+        return static_cast<Sqlite3*>(self)->_Backoff(count);
+    }
+
+    std::string _QueryPragma(const std::string& name) {
+        std::string value;
+        ExecuteCallback("PRAGMA " + name + ";", [&value](int, char** argv) {
+            value = argv[0] ? argv[0] : "";
+        });
+        return value;
+    }
+
+    /**
+     * @brief Run the pragmas of `options`.
+     * @details The page size goes first, it can't be changed any more once
+     * the database is in WAL mode.
+     */
+    void _Apply(const Sqlite3Options& options) {
+        static constexpr const char* JOURNAL_MODES[] = {
+            "DELETE", "TRUNCATE", "PERSIST", "MEMORY", "WAL", "OFF"};
+        static constexpr const char* SYNCHRONOUS[] = {"OFF", "NORMAL", "FULL",
+                                                      "EXTRA"};
+        static constexpr const char* TEMP_STORES[] = {"DEFAULT", "FILE",
+                                                      "MEMORY"};
+        if (options.pageSize)
+            Execute("PRAGMA page_size = " + std::to_string(*options.pageSize) +
+                    ";");
+        if (options.journalMode)
+            Execute(std::string("PRAGMA journal_mode = ") +
+                    JOURNAL_MODES[static_cast<int>(*options.journalMode)] +
+                    ";");
+        if (options.synchronous)
+            Execute(std::string("PRAGMA synchronous = ") +
+                    SYNCHRONOUS[static_cast<int>(*options.synchronous)] + ";");
+        if (options.cacheSize)
+            Execute("PRAGMA cache_size = " +
+                    std::to_string(*options.cacheSize) + ";");
+        if (options.mmapSize)
+            Execute("PRAGMA mmap_size = " + std::to_string(*options.mmapSize) +
+                    ";");
+        if (options.tempStore)
+            Execute(std::string("PRAGMA temp_store = ") +
+                    TEMP_STORES[static_cast<int>(*options.tempStore)] + ";");
+        if (options.busyTimeout) sqlite3_busy_timeout(db, *options.busyTimeout);
+        if (options.busyPolicy) SetBusyPolicy(*options.busyPolicy);
+    }
+
+    //! Whether only whitespace is left from `tail` up to `end`.
+    static inline bool _IsBlank(const char* tail, const char* end) {
+        while (tail && tail != end && *tail) {
+            if (!std::isspace(static_cast<unsigned char>(*tail))) return false;
+            ++tail;
+        }
+        return true;
+    }
+
+    [[noreturn]] static void _Throw(sqlite3* db, std::string_view cmd) {
+        throw std::runtime_error(std::string("SQL error: '") +
+                                 sqlite3_errmsg(db) + "' at '" +
+                                 std::string(cmd) + "'");
+    }
+
+    sqlite3_stmt* _Compile(const char* sql, int len, const char** tail,
+                           std::string_view cmd) {
+        sqlite3_stmt* stmt = nullptr;
+        std::chrono::steady_clock::time_point start;
+        if (profiling_) start = std::chrono::steady_clock::now();
+        if (sqlite3_prepare_v2(db, sql, len, &stmt, tail) != SQLITE_OK) {
+            sqlite3_finalize(stmt);
+            _Throw(db, cmd);
+        }
+        if (profiling_)
+            AddProfileTime(&ProfileStats::prepare,
+                           std::chrono::steady_clock::now() - start);
+        return stmt;
+    }
+
+    /**
+     * @brief Fetch the statement of `sql` from the cache or compile it.
+     * @details Only single statements are cached, `tail` is set to the
+     * uncompiled remainder of a multi-statement script.
+     */
+    Statement _Checkout(std::string_view sql, const char** tail) {
+        auto it = index_.find(sql);
+        if (it != index_.end() && !it->second->inUse) {
+            ++stats_.hits;
+            cache_.splice(cache_.begin(), cache_, it->second);
+            it->second->inUse = true;
+            *tail = nullptr;
+            return Statement(this, &*it->second, it->second->stmt);
+        }
+        ++stats_.misses;
+        auto stmt =
+            _Compile(sql.data(), static_cast<int>(sql.size()), tail, sql);
+        if (stmt == nullptr || it != index_.end() ||
+            !_IsBlank(*tail, sql.data() + sql.size()) || capacity_ == 0)
+            return Statement(this, nullptr, stmt);
+        _Evict(capacity_ - 1);
+        cache_.push_front(CacheEntry{std::string(sql), stmt, true});
+        index_.emplace(cache_.front().sql, cache_.begin());
+        return Statement(this, &cache_.front(), stmt);
+    }
+
+    //! Finalize idle statements from the LRU end until at most `size` remain.
+    void _Evict(size_t size) {
+        for (auto it = cache_.end();
+             index_.size() > size && it != cache_.begin();) {
+            --it;
+            if (it->inUse) continue;
+            index_.erase(it->sql);
+            sqlite3_finalize(it->stmt);
+            it = cache_.erase(it);
+            ++stats_.evictions;
+        }
+    }
+
+    static void _Step(Statement& stmt, const std::string& cmd,
+                      RowCallback* callback) {
+        while (stmt.Step()) {
+            if (callback == nullptr) continue;
+            try {
+                (*callback)(stmt.Get());
+            } catch (const std::exception& ex) {
+                throw std::runtime_error(std::string("SQL error: '") +
+                                         ex.what() + "' at '" + cmd + "'");
+            }
+        }
+    }
+
+    void _Run(const std::string& cmd, const tinyorm_impl::BoundValues& params,
+              RowCallback* callback) {
+        const char* tail = nullptr;
+        {
+            auto stmt = _Checkout(cmd, &tail);
+            stmt.Bind(params);
+            _Step(stmt, cmd, callback);
+        }
+        // The rest of a multi-statement script is never cached.
+        while (!_IsBlank(tail, cmd.data() + cmd.size())) {
+            Statement stmt(this, nullptr, _Compile(tail, -1, &tail, cmd));
+            _Step(stmt, cmd, callback);
+        }
+    }
+};
+
+/**
+ * @brief A bounded pool of backend connections to the same database.
+ * @details The pool implements the backend interface itself, so it can be
+ * used as `DBManager<ConnectionPool<Sqlite3>>`. Every call checks out a
+ * connection for its duration, hence calls from different threads run on
+ * different connections at the same time. A thread keeps its connection as
+ * long as it holds a lease or has a transaction open on it, so transactions
+ * and cursors see their own writes. At most `maxSize` connections are opened,
+ * further callers wait for one to be returned.
+ * @note Every connection opens `db_name` on its own, an in-memory database is
+ * therefore not shared between them.
+ */
+template <typename DB>
+class ConnectionPool {
+private:
+    struct Slot {
+        std::unique_ptr<DB> db;
+        //! Default id when the slot is idle or leased detached.
+        std::thread::id owner;
+        size_t leases;
+    };
+
+public:
+    /**
+     * @brief RAII checkout of a pooled connection.
+     */
+    class Connection {
+    public:
+        Connection(Connection&& other) noexcept
+            : pool_(other.pool_), slot_(other.slot_) {
+            other.slot_ = nullptr;
+        }
+        Connection& operator=(Connection&&) = delete;
+        Connection(const Connection&) = delete;
+        Connection& operator=(const Connection&) = delete;
+        ~Connection() {
+            if (slot_) pool_->_Return(*slot_);
+        }
+
+        inline DB* operator->() const { return slot_->db.get(); }
+        inline DB& operator*() const { return *slot_->db; }
+
+    private:
+        friend class ConnectionPool;
+        ConnectionPool* pool_;
+        Slot* slot_;
+
+        Connection(ConnectionPool* pool, Slot* slot)
+            : pool_(pool), slot_(slot) {}
+    };
+
+    /**
+     * @brief A prepared statement which keeps its connection checked out.
+     */
+    class Statement {
+    public:
+        inline sqlite3_stmt* Get() const { return stmt_.Get(); }
+
+        template <typename... Args>
+        void Bind(Args&&... args) {
+            stmt_.Bind(std::forward<Args>(args)...);
+        }
+
+        inline bool Step() { return stmt_.Step(); }
+        inline void Reset() { stmt_.Reset(); }
+
+    private:
+        friend class ConnectionPool;
+        Connection conn_;  //!< Outlives the statement compiled on it.
+        typename DB::Statement stmt_;
+
+        Statement(Connection&& conn, std::string_view sql)
+            : conn_(std::move(conn)), stmt_(conn_->Prepare(sql)) {}
+    };
+
+    ConnectionPool(const std::string& db_name,
+                   size_t maxSize = DEFAULT_POOL_SIZE)
+        : maxSize_(std::max<size_t>(maxSize, 1)),
+          open_([db_name]() { return std::make_unique<DB>(db_name); }) {}
+
+    //! Every connection is opened with `args` after the database name.
+    template <typename... Args>
+    ConnectionPool(const std::string& db_name, size_t maxSize,
+                   const Args&... args)
+        : maxSize_(std::max<size_t>(maxSize, 1)),
+          open_([db_name, args...]() {
+              return std::make_unique<DB>(db_name, args...);
+          }) {}
+    ConnectionPool(const ConnectionPool&) = delete;
+    ConnectionPool& operator=(const ConnectionPool&) = delete;
+    ~ConnectionPool() = default;
+
+    /**
+     * @brief Check out a connection for the calling thread.
+     * @details The connection already held by the thread is shared, otherwise
+     * an idle one is taken or a new one is opened. Blocks while the pool is
+     * exhausted.
+     */
+    inline Connection Acquire() { return _Acquire(false); }
+
+    Statement Prepare(std::string_view sql) {
+        return Statement(Acquire(), sql);
+    }
+
+    /**
+     * @brief Prepare `sql` on a connection which no thread owns.
+     * @details For a statement stepped by several threads in turn: its
+     * connection stays checked out until the statement is destroyed, and
+     * is never shared with the other calls of these threads.
+     */
+    Statement PrepareDetached(std::string_view sql) {
+        return Statement(_Acquire(true), sql);
+    }
+
+    template <typename... Args>
+    void Execute(Args&&... args) {
+        Acquire()->Execute(std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    void ExecuteCallback(Args&&... args) {
+        Acquire()->ExecuteCallback(std::forward<Args>(args)...);
+    }
+
+    inline int MaxVariableNumber() { return Acquire()->MaxVariableNumber(); }
+
+    inline auto Options() { return Acquire()->Options(); }
+
+    //! The busy wait counters summed over every connection.
+    auto BusyStats() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        decltype(slots_.front().db->BusyStats()) stats;
+        for (const auto& slot : slots_) stats += slot.db->BusyStats();
+        return stats;
+    }
+
+    //! Profile every connection, including the ones opened later.
+    void SetProfiling(bool enabled) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        profiling_ = enabled;
+        for (auto& slot : slots_) slot.db->SetProfiling(enabled);
+    }
+    inline bool Profiling() const { return profiling_; }
+
+    //! The profiles of every connection, summed.
+    ProfileStats Profile() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ProfileStats stats = profile_;
+        for (const auto& slot : slots_) stats += slot.db->Profile();
+        return stats;
+    }
+
+    void ResetProfile() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        profile_ = ProfileStats();
+        for (auto& slot : slots_) slot.db->ResetProfile();
+    }
+
+    //! Kept by the pool, timing a phase never checks out a connection.
+    void AddProfileTime(std::chrono::nanoseconds ProfileStats::*phase,
+                        std::chrono::nanoseconds elapsed) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        profile_.*phase += elapsed;
+    }
+
+    //! Number of connections opened so far.
+    inline size_t Size() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return slots_.size();
+    }
+    inline size_t MaxSize() const { return maxSize_; }
+
+private:
+    size_t maxSize_;
+    std::function<std::unique_ptr<DB>()> open_;
+    std::mutex mutex_;
+    std::condition_variable idle_;
+    std::list<Slot> slots_;  //!< A list keeps the slots in place.
+    std::atomic<bool> profiling_{false};
+    ProfileStats profile_;  //!< The phases timed outside of a connection.
+    constexpr static size_t DEFAULT_POOL_SIZE = 4;
+
+    //! A `detached` connection is leased to no thread, see PrepareDetached.
+    Connection _Acquire(bool detached) {
+        const auto self = std::this_thread::get_id();
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            Slot* idle = nullptr;
+            for (auto& slot : slots_) {
+                if (!detached && slot.owner == self) {
+                    ++slot.leases;
+                    return Connection(this, &slot);
+                }
+                if (!idle && slot.owner == std::thread::id() &&
+                    slot.leases == 0)
+                    idle = &slot;
+            }
+            if (idle == nullptr && slots_.size() < maxSize_) {
+                slots_.push_back(Slot{open_(), {}, 0});
+                if (profiling_) slots_.back().db->SetProfiling(true);
+                idle = &slots_.back();
+            }
+            if (idle) {
+                idle->owner = detached ? std::thread::id() : self;
+                idle->leases = 1;
+                return Connection(this, idle);
+            }
+            idle_.wait(lock);
+        }
+    }
+
+    //! A connection with an open transaction stays pinned to its thread.
+    void _Return(Slot& slot) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--slot.leases > 0 || slot.db->InTransaction()) return;
+        slot.owner = std::thread::id();
+        idle_.notify_one();
+    }
+};
+
+/**
+ * @brief Extract fields from the given object for the JOIN operation.
+ */
+class FieldExtractor {
+private:
+    using pair_type = std::pair<std::string_view, const std::string&>;
+    template <typename C>
+    using HasInjected = tinyorm_impl::ReflectionVisitor::HasInjected<C>;
+    //! The fields of one extracted object, found by their offset.
+    struct Entry {
+        std::uintptr_t begin;
+        size_t size;
+        const size_t* offsets;
+        const std::string_view* names;
+        size_t count;
+        const std::string* table;
+    };
+    std::vector<Entry> entries_;
+
+    template <typename T>
+    pair_type Get(const T& field) const {
+        auto address = reinterpret_cast<std::uintptr_t>(&field);
+        for (const auto& entry : entries_) {
+            if (address < entry.begin || address >= entry.begin + entry.size)
+                continue;
+            auto end = entry.offsets + entry.count;
+            auto it = std::find(entry.offsets, end, address - entry.begin);
+            if (it != end)
+                return {entry.names[it - entry.offsets], *entry.table};
+        }
+        throw std::runtime_error(NO_SUCH_FIELD);
+    }
+
+    template <typename C>
+    std::enable_if_t<!HasInjected<C>::value> Extract(const C&) {}
+
+    template <typename C>
+    std::enable_if_t<HasInjected<C>::value> Extract(const C& obj) {
+        using tinyorm_impl::ReflectionVisitor;
+        const auto& offsets = ReflectionVisitor::FieldOffsets(obj);
+        const auto& names = ReflectionVisitor::FieldNames(obj);
+        entries_.push_back({reinterpret_cast<std::uintptr_t>(&obj), sizeof(C),
+                            offsets.data(), names.data(), offsets.size(),
+                            &ReflectionVisitor::TableName(obj)});
+    }
+
+public:
+    template <typename... Classes>
+    FieldExtractor(const Classes&... args) {
+        (Extract(args), ...);
+    }
+    ~FieldExtractor() = default;
+
+    template <typename T>
+    inline tinyorm_impl::Expression::NullableField<T> operator()(
+        const Nullable<T>& field) const {
+        const auto& res = Get(field);
+        return tinyorm_impl::Expression::NullableField<T>{
+            std::string(res.first), &res.second};
+    }
+
+    template <typename T>
+    inline tinyorm_impl::Expression::Field<T> operator()(const T& field) const {
+        const auto& res = Get(field);
+        return tinyorm_impl::Expression::Field<T>{std::string(res.first),
+                                                  &res.second};
+    }
+
+    //! The column of `field` for the expression templates, see `Column`.
+    template <typename T>
+    inline tinyorm_impl::Expression::Column<T> Static(
+        const Nullable<T>& field) const {
+        const auto& res = Get(field);
+        return {&res.second, res.first};
+    }
+
+    template <typename T>
+    inline tinyorm_impl::Expression::Column<T> Static(const T& field) const {
+        const auto& res = Get(field);
+        return {&res.second, res.first};
+    }
+};
+
+/**
+ * @brief The column of a reflected member, e.g. `Col(&Order::Count)`.
+ * @details The column is named after the REFLECTION metadata of the class
+ * of the member, so unlike FieldExtractor it needs no object. It compares,
+ * assigns and selects like the columns of `FieldExtractor::Static`.
+ */
+template <typename C, typename T>
+inline tinyorm_impl::Expression::Column<
+    typename tinyorm_impl::Expression::ColumnOf<T>::type>
+Col(T C::*member) {
+    auto [name, table] = tinyorm_impl::ReflectionVisitor::Member(member);
+    return {table, name};
+}
+
+/**
+ * @brief SQL Constraint
+ * @details NOT NULL. UNIQUE, PRIMARY KEY,  FOREIGN KEY, CHECK, DEFAULT
+ */
+class Constraint {
+private:
+    std::string constraint_;
+    std::string field_;
+    template <typename DB>
+    friend class DBManager;
+
+    Constraint(std::string&& cstr, std::string field = "")
+        : constraint_(cstr), field_(std::move(field)) {}
+
+public:
+    struct CompositeField {
+        std::string fieldName_;
+        const std::string* tableName_;
+        template <typename... Args>
+        CompositeField(const Args&... args) : tableName_(nullptr) {
+            (Extract(args), ...);
+        }
+
+    private:
+        template <typename T>
+        void Extract(const tinyorm_impl::Expression::Field<T>& field) {
+            if (tableName_ != nullptr && tableName_ != field.tableName_)
+                throw std::runtime_error{NOT_THE_SAME_TABLE};
+            tableName_ = field.tableName_;
+            if (fieldName_.empty()) {
+                fieldName_ = field.fieldName_;
+            } else {
+                fieldName_ = fieldName_ + "," + field.fieldName_;
+            }
+        }
+    };
+
+    template <typename T>
+    static inline Constraint Default(
+        const tinyorm_impl::Expression::Field<T>& field, T value) {
+        std::ostringstream os;
+        tinyorm_impl::Serializer::Serialize(os << " default ", value);
+        return Constraint{os.str(), field.fieldName_};
+    }
+
+    static inline Constraint Check(
+        const tinyorm_impl::Expression::RelationExpr& expr) {
+        return Constraint{"check (" + expr.ToString() + ")"};
+    }
+
+    template <typename T>
+    static inline Constraint Unique(
+        const tinyorm_impl::Expression::Field<T>& field) {
+        return Constraint{"unique (" + field.fieldName_ + ")"};
+    }
+
+    static inline Constraint Unique(const CompositeField& field) {
+        return Constraint{"unique (" + field.fieldName_ + ")"};
+    }
+
+    template <typename T>
+    static inline Constraint Reference(
+        const tinyorm_impl::Expression::Field<T>& field,
+        const tinyorm_impl::Expression::Field<T>& refered) {
+        return Constraint{std::string("foreign key (") + field.fieldName_ +
+                          ") references " + *(refered.tableName_) + "(" +
+                          refered.fieldName_ + ")"};
+    }
+
+    static inline Constraint Reference(const CompositeField& fields,
+                                       const CompositeField& refereds) {
+        return Constraint{std::string("foreign key (") + fields.fieldName_ +
+                          ") references " + *(refereds.tableName_) + "(" +
+                          refereds.fieldName_ + ")"};
+    }
+};
+
+/**
+ * @brief Options of DBManager::CreateIndex besides the plain key columns.
+ */
+class Index {
+private:
+    std::string key_;
+    const std::string* table_ = nullptr;
+    std::string where_;
+    bool unique_ = false;
+    template <typename DB>
+    friend class DBManager;
+
+    Index() = default;
+
+    /**
+     * @brief The key without the qualifier of `table`, which is not allowed
+     * in an index.
+     * @details A CalculateField carries no table, its qualified columns are
+     * stripped from its text. A column of another table throws.
+     */
+    std::string _Key(const std::string& table) const {
+        if (table_ && *table_ != table)
+            throw std::runtime_error{NOT_THE_SAME_TABLE};
+        const std::string prefix = table + ".";
+        std::string ret;
+        size_t pos = 0;
+        for (size_t next;
+             (next = key_.find(prefix, pos)) != std::string::npos;
+             pos = next + prefix.size()) {
+            ret.append(key_, pos, next - pos);
+            char prev = next ? key_[next - 1] : ' ';
+            if (std::isalnum(static_cast<unsigned char>(prev)) || prev == '_')
+                ret += prefix;
+        }
+        return ret.append(key_, pos);
+    }
+
+public:
+    //! A key column or expression in ascending order, the default.
+    template <typename T>
+    static inline Index Asc(
+        const tinyorm_impl::Expression::FieldBase<T>& field) {
+        Index ret;
+        ret.key_ = field.fieldName_;
+        ret.table_ = field.tableName_;
+        return ret;
+    }
+
+    static inline Index Asc(const Constraint::CompositeField& fields) {
+        Index ret;
+        ret.key_ = fields.fieldName_;
+        ret.table_ = fields.tableName_;
+        return ret;
+    }
+
+    template <typename T>
+    static inline Index Desc(
+        const tinyorm_impl::Expression::FieldBase<T>& field) {
+        Index ret = Asc(field);
+        ret.key_ += " desc";
+        return ret;
+    }
+
+    //! Reject two rows with the same keys.
+    static inline Index Unique() {
+        Index ret;
+        ret.unique_ = true;
+        return ret;
+    }
+
+    //! Only index the rows matching `expr`, i.e. a partial index.
+    static inline Index Where(
+        const tinyorm_impl::Expression::RelationExpr& expr) {
+        Index ret;
+        ret.where_ = expr.ToString(false);
+        return ret;
+    }
+};
+
+template <typename Result, typename DB>
+class QueryResult;
+}  // namespace tinyorm
+
+namespace tinyorm_impl {
+
+class QueryHelper {
+    template <typename T>
+    using Nullable = tinyorm::Nullable<T>;
+
+    template <typename T>
+    using Selectable = tinyorm_impl::Expression::FieldBase<T>;
+
+    template <typename T>
+    struct TypeToNullable {
+        using type = Nullable<T>;
+    };
+
+    template <typename T>
+    struct TypeToNullable<Nullable<T>> : public TypeToNullable<T> {};
+
+    template <typename T>
+    friend class tinyorm::QueryResult;
+
+    template <typename Fn, typename TupleType>
+    static inline void TupleVisit(TupleType& tuple, Fn&& fn) {
+        auto func = [&fn](auto&&... args) { ((fn(args)), ...); };
+        std::apply(func, tuple);
+    }
+
+    template <typename... Args>
+    static inline auto FieldsToNullable(Args...) {
+        return std::tuple<typename TypeToNullable<Args>::type...>{};
+    }
+
+    template <typename C>
+    static inline auto QueryResultToTuple(const C& entity) {
+        return tinyorm_impl::ReflectionVisitor::Visit(
+            entity, [](auto... args) { return FieldsToNullable(args...); });
+    }
+
+    template <typename... Args>
+    static inline auto JoinToTuple(const Args&... args) {
+        return decltype(std::tuple_cat(QueryResultToTuple(args)...)){};
+    }
+
+    template <typename T>
+    static inline auto SelectableToTuple(const Selectable<T>&) {
+        return Nullable<T>{};
+    }
+
+    template <typename... Args>
+    static inline auto SelectToTuple(const Args&... args) {
+        return std::tuple<decltype(SelectableToTuple(args))...>{};
+    }
+
+    template <typename T>
+    static inline auto SelectableToTuple(const Expression::Column<T>&) {
+        return Nullable<T>{};
+    }
+
+    //! The comma separated list of the fields and columns `args`.
+    template <typename... Args>
+    static inline std::string FieldToSql(const Args&... args) {
+        std::string ret;
+        ((args.AppendTo(ret), ret += ","), ...);
+        ret.pop_back();
+        return ret;
+    }
+};
+
+/**
+ * @brief One clause of a query built by tinyorm::QueryResult.
+ * @details The clauses of a query form an immutable list, newest first,
+ * which is shared by all the queries built from it: a builder call links one
+ * clause in front of the list it starts from, and copies nothing else. The
+ * list is rendered to SQL once, when the query is executed.
+ */
+class QueryClause {
+public:
+    using Ptr = std::shared_ptr<const QueryClause>;
+    using RelationExpr = Expression::RelationExpr;
+
+    enum class Kind {
+        From,
+        Distinct,
+        Target,
+        Join,
+        Compound,
+        Where,
+        GroupBy,
+        Having,
+        OrderBy,
+        Limit,
+        Offset,
+    };
+
+    //! A rendered query and the values bound to its placeholders, in order.
+    struct Rendered {
+        std::string sql;
+        BoundValues values;
+    };
+
+    QueryClause(Kind kind, Ptr prev) : kind_(kind), prev_(std::move(prev)) {}
+
+    static Ptr From(std::string_view table) {
+        auto ret = std::make_shared<QueryClause>(Kind::From, nullptr);
+        ret->table_ = table;
+        return ret;
+    }
+
+    static Ptr Distinct(Ptr prev) {
+        return std::make_shared<QueryClause>(Kind::Distinct, std::move(prev));
+    }
+
+    static Ptr Target(Ptr prev, std::string columns) {
+        auto ret = std::make_shared<QueryClause>(Kind::Target, std::move(prev));
+        ret->text_ = std::move(columns);
+        return ret;
+    }
+
+    //! `keyword` is " join " or " left join ".
+    static Ptr Join(Ptr prev, std::string_view keyword, std::string_view table,
+                    RelationExpr onExpr) {
+        auto ret = std::make_shared<QueryClause>(Kind::Join, std::move(prev));
+        ret->keyword_ = keyword;
+        ret->table_ = table;
+        ret->expr_.emplace(std::move(onExpr));
+        return ret;
+    }
+
+    //! `keyword` is " union ", " except " ... applied with `other`.
+    static Ptr Compound(Ptr prev, std::string_view keyword, Ptr other) {
+        auto ret =
+            std::make_shared<QueryClause>(Kind::Compound, std::move(prev));
+        ret->keyword_ = keyword;
+        ret->other_ = std::move(other);
+        return ret;
+    }
+
+    static Ptr Where(Ptr prev, RelationExpr expr) {
+        auto ret = std::make_shared<QueryClause>(Kind::Where, std::move(prev));
+        ret->expr_.emplace(std::move(expr));
+        return ret;
+    }
+
+    //! A condition of the shape of a static expression, see `Shape()`.
+    template <typename E>
+    static Ptr Where(Ptr prev, const E& expr,
+                     std::enable_if_t<Expression::IsStaticExpr<E>::value>* =
+                         nullptr) {
+        auto ret = std::make_shared<QueryClause>(Kind::Where, std::move(prev));
+        ret->shape_ = Expression::Shape(expr);
+        ret->values_ = expr.Values();
+        return ret;
+    }
+
+    static Ptr GroupBy(Ptr prev, std::string columns) {
+        auto ret =
+            std::make_shared<QueryClause>(Kind::GroupBy, std::move(prev));
+        ret->text_ = std::move(columns);
+        return ret;
+    }
+
+    static Ptr Having(Ptr prev, RelationExpr expr) {
+        auto ret = std::make_shared<QueryClause>(Kind::Having, std::move(prev));
+        ret->expr_.emplace(std::move(expr));
+        return ret;
+    }
+
+    template <typename E>
+    static Ptr Having(Ptr prev, const E& expr,
+                      std::enable_if_t<Expression::IsStaticExpr<E>::value>* =
+                          nullptr) {
+        auto ret = std::make_shared<QueryClause>(Kind::Having, std::move(prev));
+        ret->shape_ = Expression::Shape(expr);
+        ret->values_ = expr.Values();
+        return ret;
+    }
+
+    //! Appends `columns` to the ordering of the query.
+    static Ptr OrderBy(Ptr prev, std::string columns, bool descending) {
+        auto ret =
+            std::make_shared<QueryClause>(Kind::OrderBy, std::move(prev));
+        ret->text_ = std::move(columns);
+        ret->descending_ = descending;
+        return ret;
+    }
+
+    static Ptr Limit(Ptr prev, size_t count) {
+        auto ret = std::make_shared<QueryClause>(Kind::Limit, std::move(prev));
+        ret->count_ = count;
+        return ret;
+    }
+
+    static Ptr Offset(Ptr prev, size_t count) {
+        auto ret = std::make_shared<QueryClause>(Kind::Offset, std::move(prev));
+        ret->count_ = count;
+        return ret;
+    }
+
+    /**
+     * @brief Render the select statement of the clauses ending at `head`.
+     * @param target replaces the selected columns when not empty, e.g. by an
+     * aggregate function.
+     */
+    static Rendered Render(const Ptr& head, std::string_view target = {}) {
+        State state;
+        state.Collect(*head);
+        Rendered ret;
+        ret.sql.reserve(RENDER_CAPACITY);
+        state.AppendSelect(ret.sql, target);
+        state.AppendFrom(ret.sql, ret.values);
+        ret.sql += state.orderBy;
+        if (state.limit || state.offset) {
+            ret.sql += " limit ";
+            ret.sql += state.limit ? std::to_string(*state.limit) : "~0";
+        }
+        if (state.offset) ret.sql += " offset " + std::to_string(*state.offset);
+        ret.sql += ";";
+        return ret;
+    }
+
+private:
+    //! Most statements render without growing their buffer.
+    constexpr static size_t RENDER_CAPACITY = 256;
+    Kind kind_;
+    Ptr prev_;
+    std::string_view keyword_;
+    std::string_view table_;
+    std::string text_;
+    std::optional<RelationExpr> expr_;
+    std::shared_ptr<const std::string> shape_;  //!< Or a static expression
+    BoundValues values_;                         //!< with these values
+    Ptr other_;
+    size_t count_ = 0;
+    bool descending_ = false;
+
+    //! Append the condition of the clause and its values.
+    inline void AppendCondition(std::string& sql, BoundValues& values) const {
+        if (shape_) {
+            sql += *shape_;
+            values.insert(values.end(), values_.begin(), values_.end());
+        } else {
+            expr_->AppendSql(sql);
+            values.insert(values.end(), expr_->Values().begin(),
+                          expr_->Values().end());
+        }
+    }
+
+    //! The query described by a list of clauses, applied oldest first.
+    struct State {
+        bool distinct = false;
+        const std::string* target = nullptr;
+        std::string from;
+        BoundValues fromValues;
+        const QueryClause* where = nullptr;
+        const std::string* groupBy = nullptr;
+        const QueryClause* having = nullptr;
+        std::string orderBy;
+        std::optional<size_t> limit;
+        std::optional<size_t> offset;
+
+        void Collect(const QueryClause& clause) {
+            if (clause.prev_) Collect(*clause.prev_);
+            Apply(clause);
+        }
+
+        void Apply(const QueryClause& clause) {
+            switch (clause.kind_) {
+                case Kind::From:
+                    from.assign(" from ").append(clause.table_);
+                    break;
+                case Kind::Distinct:
+                    distinct = true;
+                    break;
+                case Kind::Target:
+                    target = &clause.text_;
+                    break;
+                case Kind::Join:
+                    from.append(clause.keyword_)
+                        .append(clause.table_)
+                        .append(" on ");
+                    clause.AppendCondition(from, fromValues);
+                    break;
+                case Kind::Compound:
+                    ApplyCompound(clause);
+                    break;
+                case Kind::Where:
+                    where = &clause;
+                    break;
+                case Kind::GroupBy:
+                    groupBy = &clause.text_;
+                    break;
+                case Kind::Having:
+                    having = &clause;
+                    break;
+                case Kind::OrderBy:
+                    orderBy.append(orderBy.empty() ? " order by " : ",")
+                        .append(clause.text_);
+                    if (clause.descending_) orderBy += " desc";
+                    break;
+                case Kind::Limit:
+                    limit = clause.count_;
+                    break;
+                case Kind::Offset:
+                    offset = clause.count_;
+                    break;
+            }
+        }
+
+        //! The compound query becomes the source of the following clauses.
+        void ApplyCompound(const QueryClause& clause) {
+            std::string sql;
+            BoundValues values;
+            AppendFrom(sql, values);
+            State other;
+            other.Collect(*clause.other_);
+            sql.append(clause.keyword_);
+            other.AppendSelect(sql);
+            other.AppendFrom(sql, values);
+            from = std::move(sql);
+            fromValues = std::move(values);
+            where = having = nullptr;
+            groupBy = nullptr;
+        }
+
+        void AppendSelect(std::string& sql,
+                          std::string_view columns = {}) const {
+            sql += distinct ? "select distinct " : "select ";
+            if (!columns.empty())
+                sql += columns;
+            else
+                sql += target ? *target : "*";
+        }
+
+        void AppendFrom(std::string& sql, BoundValues& values) const {
+            sql += from;
+            values.insert(values.end(), fromValues.begin(), fromValues.end());
+            if (where) {
+                sql += " where (";
+                where->AppendCondition(sql, values);
+                sql += ")";
+            }
+            if (groupBy) sql.append(" group by ").append(*groupBy);
+            if (having) {
+                sql += " having ";
+                having->AppendCondition(sql, values);
+            }
+        }
+    };
+};
+
+//! A phase of the profile, e.g. &ProfileStats::decode.
+using ProfilePhase = std::chrono::nanoseconds tinyorm::ProfileStats::*;
+
+/**
+ * @brief Adds the time of its scope to a phase of the profile of a backend,
+ * if the backend is profiling.
+ * @details Backends without profiling support cost nothing.
+ */
+template <typename DB, typename = void>
+class ProfileTimer {
+public:
+    ProfileTimer(DB&, ProfilePhase) {}
+    static inline bool Enabled(DB&) { return false; }
+    static inline void Add(DB&, ProfilePhase, std::chrono::nanoseconds) {}
+};
+
+template <typename DB>
+class ProfileTimer<DB, std::void_t<decltype(std::declval<DB&>().Profiling())>> {
+public:
+    ProfileTimer(DB& db, ProfilePhase phase)
+        : db_(Enabled(db) ? &db : nullptr), phase_(phase) {
+        if (db_) start_ = std::chrono::steady_clock::now();
+    }
+    ProfileTimer(const ProfileTimer&) = delete;
+    ProfileTimer& operator=(const ProfileTimer&) = delete;
+    ~ProfileTimer() {
+        if (db_) Add(*db_, phase_, std::chrono::steady_clock::now() - start_);
+    }
+
+    static inline bool Enabled(DB& db) { return db.Profiling(); }
+    static inline void Add(DB& db, ProfilePhase phase,
+                           std::chrono::nanoseconds elapsed) {
+        db.AddProfileTime(phase, elapsed);
+    }
+
+private:
+    DB* db_;
+    ProfilePhase phase_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ * @brief A bounded pool of worker threads, each one owning a connection.
+ * @details Workers are started on demand, up to `maxWorkers`, and open their
+ * connection before running their first task, with `connect` if given and
+ * `open` otherwise. Pending tasks are still run when the executor is shut
+ * down, and the workers may still queue tasks until they are done. Tasks of
+ * other threads are rejected from then on. The workers share their state
+ * with the executor, so that a task may drop the last reference to it:
+ * that worker is detached instead of joined, and finishes the queue on its
+ * own.
+ */
+template <typename DB>
+class Executor {
+public:
+    using Connection = std::shared_ptr<DB>;
+    using Opener = std::function<Connection()>;
+
+    Executor(Opener open, size_t maxWorkers, Opener connect = nullptr)
+        : core_(std::make_shared<Core>(std::move(open), std::move(connect),
+                                       std::max<size_t>(maxWorkers, 1))) {}
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+    ~Executor() { Shutdown(); }
+
+    //! Run the pending tasks and stop the workers, see the class details.
+    void Shutdown() {
+        std::vector<std::thread> workers;
+        {
+            std::lock_guard<std::mutex> lock(core_->mutex);
+            core_->stopping = true;
+            workers.swap(workers_);
+        }
+        core_->ready.notify_all();
+        for (auto& worker : workers) {
+            if (worker.get_id() == std::this_thread::get_id())
+                worker.detach();
+            else
+                worker.join();
+        }
+    }
+
+    void SetMaxWorkers(size_t maxWorkers) {
+        std::lock_guard<std::mutex> lock(core_->mutex);
+        core_->maxWorkers = std::max<size_t>(maxWorkers, 1);
+    }
+
+    /**
+     * @brief Run `fn` with the connection of a worker.
+     * @details `fn` is called with a `const std::shared_ptr<DB>&`, its result
+     * or exception is delivered through the future. Submitted by one of the
+     * workers, `fn` runs at once on the connection of that worker, so that
+     * nested work never waits for a worker held by its caller.
+     */
+    template <typename Fn>
+    auto Submit(Fn&& fn) {
+        using R = std::invoke_result_t<Fn&, const Connection&>;
+        auto task = std::make_shared<std::packaged_task<R(Connection&)>>(
+            [core = core_.get(),
+             fn = std::forward<Fn>(fn)](Connection& db) mutable {
+                return fn(static_cast<const Connection&>(core->Connect(db)));
+            });
+        auto future = task->get_future();
+        if (current_ == core_.get())
+            (*task)(*currentDb_);
+        else
+            Post([task](Connection& db) { (*task)(db); });
+        return future;
+    }
 
-    template <typename T>
-    const pair_type& Get(const T& field) const {
-        try {
-            return fieldCache_.at((const void*)&field);
-        } catch (...) {
-            throw(std::runtime_error(NO_SUCH_FIELD));
+    /**
+     * @brief Queue `fn(Connection&)` without a future.
+     * @details The connection of the worker is handed over unopened before
+     * its first use, see `Connect`.
+     * @throw std::runtime_error if the executor is shut down and the caller
+     * is not one of its workers, which run the queue until it is empty.
+     */
+    void Post(std::function<void(Connection&)> fn) {
+        {
+            std::lock_guard<std::mutex> lock(core_->mutex);
+            if (core_->stopping) {
+                if (current_ != core_.get())
+                    throw std::runtime_error(EXECUTOR_STOPPED);
+            } else if (core_->queue.size() >= core_->idle &&
+                       workers_.size() < core_->maxWorkers) {
+                workers_.emplace_back(&Executor::_Work, core_);
+            }
+            core_->queue.push_back(std::move(fn));
         }
+        core_->ready.notify_one();
     }
 
-    template <typename C>
-    std::enable_if_t<!HasInjected<C>::value> Extract(const C&) {}
+    //! Open the connection of a worker unless it is open already.
+    inline Connection& Connect(Connection& db) { return core_->Connect(db); }
 
-    template <typename C>
-    std::enable_if_t<HasInjected<C>::value> Extract(const C& obj) {
-        tinyorm_impl::ReflectionVisitor::Visit(
-            obj, [this, &obj](const auto&... args) {
-                const auto& tableName =
-                    tinyorm_impl::ReflectionVisitor::TableName(obj);
-                const auto& fieldNames =
-                    tinyorm_impl::ReflectionVisitor::FieldNames(obj);
-                int index = 0;
-                (fieldCache_.emplace(&args,
-                                     pair_type{fieldNames[index++], tableName}),
-                 ...);
-            });
-    }
+    //! Open a connection which doesn't belong to any worker.
+    inline Connection Open() { return core_->open(); }
 
-public:
-    template <typename... Classes>
-    FieldExtractor(const Classes&... args) {
-        (Extract(args), ...);
-    }
-    ~FieldExtractor() = default;
+private:
+    //! The state shared with the workers.
+    struct Core {
+        Core(Opener opener, Opener connector, size_t workers)
+            : open(std::move(opener)),
+              connect(connector ? std::move(connector) : open),
+              maxWorkers(workers) {}
+
+        inline Connection& Connect(Connection& db) {
+            if (!db) db = connect();
+            return db;
+        }
 
-    template <typename T>
-    inline tinyorm_impl::Expression::NullableField<T> operator()(
-        const Nullable<T>& field) const {
-        const auto& res = Get(field);
-        return tinyorm_impl::Expression::NullableField<T>{std::move(res.first),
-                                                          &res.second};
-    }
+        Opener open;
+        Opener connect;
+        size_t maxWorkers;
+        size_t idle = 0;
+        bool stopping = false;
+        std::mutex mutex;
+        std::condition_variable ready;
+        std::list<std::function<void(Connection&)>> queue;
+    };
 
-    template <typename T>
-    inline tinyorm_impl::Expression::Field<T> operator()(const T& field) const {
-        const auto& res = Get(field);
-        return tinyorm_impl::Expression::Field<T>{std::move(res.first),
-                                                  &res.second};
+    std::shared_ptr<Core> core_;
+    std::vector<std::thread> workers_;
+    //! The state and the connection of the calling worker thread.
+    static inline thread_local Core* current_ = nullptr;
+    static inline thread_local Connection* currentDb_ = nullptr;
+
+    static void _Work(std::shared_ptr<Core> core) {
+        Connection db;
+        current_ = core.get();
+        currentDb_ = &db;
+        std::unique_lock<std::mutex> lock(core->mutex);
+        for (;;) {
+            ++core->idle;
+            core->ready.wait(lock, [&core]() {
+                return core->stopping || !core->queue.empty();
+            });
+            --core->idle;
+            if (core->queue.empty()) return;
+            auto task = std::move(core->queue.front());
+            core->queue.pop_front();
+            lock.unlock();
+            task(db);
+            task = nullptr;
+            lock.lock();
+        }
     }
 };
 
+#ifdef TINYORM_HAS_COROUTINE
 /**
- * @brief SQL Constraint
- * @details NOT NULL. UNIQUE, PRIMARY KEY,  FOREIGN KEY, CHECK, DEFAULT
+ * @brief Awaitable running `work` on a worker of an Executor.
+ * @details The awaiting coroutine is resumed on the worker thread as soon as
+ * the work is done, `co_await` then returns its result or rethrows its
+ * exception.
  */
-class Constraint {
-private:
-    std::string constraint_;
-    std::string field_;
-    template <typename DB>
-    friend class DBManager;
-
-    Constraint(std::string&& cstr, std::string field = "")
-        : constraint_(cstr), field_(std::move(field)) {}
-
+template <typename DB, typename R>
+class Awaitable {
 public:
-    struct CompositeField {
-        std::string fieldName_;
-        const std::string* tableName_;
-        template <typename... Args>
-        CompositeField(const Args&... args) : tableName_(nullptr) {
-            (Extract(args), ...);
-        }
-
-    private:
-        template <typename T>
-        void Extract(const tinyorm_impl::Expression::Field<T>& field) {
-            if (tableName_ != nullptr && tableName_ != field.tableName_)
-                throw std::runtime_error{NOT_THE_SAME_TABLE};
-            tableName_ = field.tableName_;
-            if (fieldName_.empty()) {
-                fieldName_ = field.fieldName_;
-            } else {
-                fieldName_ = fieldName_ + "," + field.fieldName_;
+    using Work = std::function<R(const std::shared_ptr<DB>&)>;
+
+    Awaitable(std::shared_ptr<Executor<DB>> executor, Work work)
+        : executor_(std::move(executor)), work_(std::move(work)) {}
+
+    inline bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+        executor_->Post([this, handle](std::shared_ptr<DB>& db) {
+            try {
+                const auto& conn = executor_->Connect(db);
+                if constexpr (std::is_void_v<R>)
+                    work_(conn);
+                else
+                    result_.emplace(work_(conn));
+            } catch (...) {
+                error_ = std::current_exception();
             }
-        }
-    };
-
-    template <typename T>
-    static inline Constraint Default(
-        const tinyorm_impl::Expression::Field<T>& field, T value) {
-        std::ostringstream os;
-        tinyorm_impl::Serializer::Serialize(os << " default ", value);
-        return Constraint{os.str(), field.fieldName_};
+            handle.resume();
+        });
     }
 
-    static inline Constraint Check(
-        const tinyorm_impl::Expression::RelationExpr& expr) {
-        return Constraint{"check (" + expr.ToString() + ")"};
+    R await_resume() {
+        if (error_) std::rethrow_exception(error_);
+        if constexpr (!std::is_void_v<R>) return std::move(*result_);
     }
 
-    template <typename T>
-    static inline Constraint Unique(
-        const tinyorm_impl::Expression::Field<T>& field) {
-        return Constraint{"unique (" + field.fieldName_ + ")"};
+private:
+    using Value = std::conditional_t<std::is_void_v<R>, std::monostate, R>;
+    std::shared_ptr<Executor<DB>> executor_;
+    Work work_;
+    std::optional<Value> result_;
+    std::exception_ptr error_;
+};
+#endif
+
+}  // namespace tinyorm_impl
+
+namespace tinyorm {
+
+/**
+ * @brief The plan of a query, as reported by `EXPLAIN QUERY PLAN`.
+ */
+struct QueryPlan {
+    struct Step {
+        int id = 0;
+        std::string detail;  //!< e.g. "SCAN T" or "SEARCH T USING INDEX ..."
+        std::vector<Step> children;
+    };
+    std::vector<Step> steps;  //!< The top level steps, in plan order.
+
+    //! The tables read by a full scan, in plan order.
+    std::vector<std::string> ScannedTables() const {
+        std::vector<std::string> ret;
+        _ScannedTables(steps, ret);
+        return ret;
     }
 
-    static inline Constraint Unique(const CompositeField& field) {
-        return Constraint{"unique (" + field.fieldName_ + ")"};
+    //! The tree drawn like the `.eqp` output of the sqlite3 shell.
+    std::string ToString() const {
+        std::string ret = "QUERY PLAN\n";
+        _Draw(steps, "", ret);
+        return ret;
     }
 
-    template <typename T>
-    static inline Constraint Reference(
-        const tinyorm_impl::Expression::Field<T>& field,
-        const tinyorm_impl::Expression::Field<T>& refered) {
-        return Constraint{std::string("foreign key (") + field.fieldName_ +
-                          ") references " + *(refered.tableName_) + "(" +
-                          refered.fieldName_ + ")"};
+private:
+    static void _ScannedTables(const std::vector<Step>& steps,
+                               std::vector<std::string>& out) {
+        for (const auto& step : steps) {
+            std::string_view detail = step.detail;
+            if (detail.substr(0, 5) == "SCAN ") {
+                detail.remove_prefix(5);
+                // SQLite before 3.36 reports "SCAN TABLE T".
+                if (detail.substr(0, 6) == "TABLE ") detail.remove_prefix(6);
+                auto table = detail.substr(0, detail.find(' '));
+                // Subqueries and "SCAN CONSTANT ROW" don't read a table.
+                if (!table.empty() && table.front() != '(' &&
+                    table != "CONSTANT")
+                    out.emplace_back(table);
+            }
+            _ScannedTables(step.children, out);
+        }
     }
 
-    static inline Constraint Reference(const CompositeField& fields,
-                                       const CompositeField& refereds) {
-        return Constraint{std::string("foreign key (") + fields.fieldName_ +
-                          ") references " + *(refereds.tableName_) + "(" +
-                          refereds.fieldName_ + ")"};
+    static void _Draw(const std::vector<Step>& steps,
+                      const std::string& indent, std::string& out) {
+        for (const auto& step : steps) {
+            bool last = &step == &steps.back();
+            out += indent + (last ? "`--" : "|--") + step.detail + "\n";
+            _Draw(step.children, indent + (last ? "   " : "|  "), out);
+        }
     }
 };
 
-template <typename Result, typename DB>
-class QueryResult;
-}  // namespace tinyorm
+/**
+ * @brief Debug check for full table scans in the queries of a DBManager.
+ * @details Before a query runs, every table its plan scans is counted up to
+ * `maxRows + 1` rows. If a scanned table holds more than `maxRows` rows,
+ * `onScan(table, sql)` is called, or a std::runtime_error is thrown if
+ * there is no handler. The handler of an async query runs on the worker.
+ */
+struct ScanCheck {
+    size_t maxRows = 0;
+    std::function<void(const std::string& table, const std::string& sql)>
+        onScan;
+};
 
-namespace tinyorm_impl {
+/**
+ * @brief A query reported by the SlowQueryLog.
+ */
+struct SlowQuery {
+    std::string sql;                      //!< With `?` placeholders.
+    tinyorm_impl::BoundValues values;     //!< Empty if redacted.
+    std::chrono::nanoseconds elapsed{0};  //!< Wall time of the execution.
+    size_t rows = 0;                      //!< Rows returned.
+    QueryPlan plan;
+};
 
-class QueryHelper {
-    template <typename T>
-    using Nullable = tinyorm::Nullable<T>;
+/**
+ * @brief Report the queries of a DBManager running for `threshold` or
+ * longer to `onSlow`.
+ * @details The plan is only explained once a query turned out slow, fast
+ * queries just read the clock twice. The handler of an async query runs on
+ * the worker.
+ */
+struct SlowQueryLog {
+    std::chrono::nanoseconds threshold{0};
+    std::function<void(const SlowQuery&)> onSlow;
+    bool redactValues = false;  //!< Leave SlowQuery::values empty.
+};
 
-    template <typename T>
-    using Selectable = tinyorm_impl::Expression::FieldBase<T>;
+template <typename Result, typename DB>
+class QueryResult {
+private:
+    template <typename C>
+    using HasInjected = tinyorm_impl::ReflectionVisitor::HasInjected<C>;
 
-    template <typename T>
-    struct TypeToNullable {
-        using type = Nullable<T>;
-    };
+    template <typename Q, typename D>
+    friend class QueryResult;
+    template <typename D>
+    friend class DBManager;
 
-    template <typename T>
-    struct TypeToNullable<Nullable<T>> : public TypeToNullable<T> {};
+    std::shared_ptr<DB> dbhandler_;
+    std::shared_ptr<tinyorm_impl::Executor<DB>> executor_;
+    std::shared_ptr<const ScanCheck> scanCheck_;
+    std::shared_ptr<const SlowQueryLog> slowLog_;
+    Result _queryHelper;
+    tinyorm_impl::QueryClause::Ptr _clauses;
 
-    template <typename T>
-    friend class tinyorm::QueryResult;
+    QueryResult(std::shared_ptr<DB> db_ptr, Result queryHelper,
+                tinyorm_impl::QueryClause::Ptr clauses)
+        : dbhandler_(std::move(db_ptr)),
+          _queryHelper(std::move(queryHelper)),
+          _clauses(std::move(clauses)) {}
+
+    inline tinyorm_impl::QueryClause::Rendered _Render(
+        std::string_view target = {}) const {
+        return tinyorm_impl::QueryClause::Render(_clauses, target);
+    }
 
-    template <typename Fn, typename TupleType>
-    static inline void TupleVisit(TupleType& tuple, Fn&& fn) {
-        auto func = [&fn](auto&&... args) { ((fn(args)), ...); };
-        std::apply(func, tuple);
+    inline QueryResult _With(tinyorm_impl::QueryClause::Ptr clauses) const& {
+        auto ret = *this;
+        ret._clauses = std::move(clauses);
+        return ret;
     }
 
-    template <typename... Args>
-    static inline auto FieldsToNullable(Args...) {
-        return std::tuple<typename TypeToNullable<Args>::type...>{};
+    inline QueryResult _With(tinyorm_impl::QueryClause::Ptr clauses) && {
+        _clauses = std::move(clauses);
+        return std::move(*this);
     }
 
+    // Column count of Normal Objects
     template <typename C>
-    static inline auto QueryResultToTuple(const C& entity) {
+    static inline size_t _ColumnCount(const C& row) {
         return tinyorm_impl::ReflectionVisitor::Visit(
-            entity, [](auto... args) { return FieldsToNullable(args...); });
+            row, [](const auto&... args) { return sizeof...(args); });
     }
 
+    // Column count of Tuples
     template <typename... Args>
-    static inline auto JoinToTuple(const Args&... args) {
-        return decltype(std::tuple_cat(QueryResultToTuple(args)...)){};
+    static inline size_t _ColumnCount(const std::tuple<Args...>&) {
+        return sizeof...(Args);
     }
 
-    template <typename T>
-    static inline auto SelectableToTuple(const Selectable<T>&) {
-        return Nullable<T>{};
+    static inline void _CheckColumns(const Result& row, sqlite3_stmt* stmt) {
+        auto columns = static_cast<size_t>(sqlite3_column_count(stmt));
+        if (_ColumnCount(row) != columns)
+            throw std::runtime_error(BAD_COLUMN_COUNT);
     }
 
+    // Decode a row into Normal Objects
+    template <typename C>
+    static inline void _Decode(C& row, sqlite3_stmt* stmt) {
+        tinyorm_impl::ReflectionVisitor::Visit(row, [stmt](auto&... args) {
+            int idx = 0;
+            ((tinyorm_impl::Deserializer::Deserialize(args, stmt, idx++)),
+             ...);
+        });
+    }
+
+    // Decode a row into Tuples
     template <typename... Args>
-    static inline auto SelectToTuple(const Args&... args) {
-        return std::tuple<decltype(SelectableToTuple(args))...>{};
+    static inline void _Decode(std::tuple<Args...>& row, sqlite3_stmt* stmt) {
+        int idx = 0;
+        tinyorm_impl::QueryHelper::TupleVisit(row, [stmt, &idx](auto& val) {
+            tinyorm_impl::Deserializer::Deserialize(val, stmt, idx++);
+        });
     }
 
-    template <typename T>
-    static inline std::string FieldToSql(const Selectable<T>& op) {
-        if (op.tableName_)
-            return (*op.tableName_) + "." + op.fieldName_;
-        else
-            return op.fieldName_;
+    //! Run `EXPLAIN QUERY PLAN` on a rendered query.
+    static inline QueryPlan _Explain(
+        DB& db, const tinyorm_impl::QueryClause::Rendered& query) {
+        QueryPlan plan;
+        // The steps come depth first, `path` holds the ancestors of the
+        // next one.
+        std::vector<QueryPlan::Step*> path;
+        db.ExecuteCallback(
+            "explain query plan " + query.sql, query.values,
+            [&plan, &path](sqlite3_stmt* stmt) {
+                int id = sqlite3_column_int(stmt, 0);
+                int parent = sqlite3_column_int(stmt, 1);
+                auto detail = sqlite3_column_text(stmt, 3);
+                while (!path.empty() && path.back()->id != parent)
+                    path.pop_back();
+                auto& steps = path.empty() ? plan.steps : path.back()->children;
+                steps.push_back(
+                    {id, detail ? reinterpret_cast<const char*>(detail) : "",
+                     {}});
+                path.push_back(&steps.back());
+            });
+        return plan;
     }
 
-    template <typename T, typename... Args>
-    static inline std::string FieldToSql(const Selectable<T>& arg,
-                                         const Args&... args) {
-        return FieldToSql(arg) + "," + FieldToSql(args...);
+    //! Report the large tables scanned by `query` to `check`, if any.
+    static inline void _CheckScans(
+        DB& db, const ScanCheck* check,
+        const tinyorm_impl::QueryClause::Rendered& query) {
+        if (!check) return;
+        for (const auto& table : _Explain(db, query).ScannedTables()) {
+            size_t rows = 0;
+            db.ExecuteCallback(
+                "select count(*) from (select 1 from " + table + " limit " +
+                    std::to_string(check->maxRows + 1) + ");",
+                tinyorm_impl::BoundValues{}, [&rows](sqlite3_stmt* stmt) {
+                    rows = static_cast<size_t>(sqlite3_column_int64(stmt, 0));
+                });
+            if (rows <= check->maxRows) continue;
+            if (!check->onScan)
+                throw std::runtime_error(std::string(FULL_SCAN) + " '" +
+                                         table + "' at '" + query.sql + "'");
+            check->onScan(table, query.sql);
+        }
     }
-};
 
-}  // namespace tinyorm_impl
+    using Timer = tinyorm_impl::ProfileTimer<DB>;
 
-namespace tinyorm {
+    //! Backends with `PrepareDetached`, i.e. connection pools.
+    template <typename D, typename = void>
+    struct Detachable : std::false_type {};
+    template <typename D>
+    struct Detachable<D, std::void_t<decltype(std::declval<D&>()
+                                                  .PrepareDetached({}))>>
+        : std::true_type {};
+
+    //! `_Render`, timed as ProfileStats::build.
+    inline tinyorm_impl::QueryClause::Rendered _Build(
+        DB& db, std::string_view target = {}) const {
+        Timer timer(db, &ProfileStats::build);
+        return _Render(target);
+    }
 
-template <typename Result, typename DB>
-class QueryResult {
-private:
-    template <typename C>
-    using HasInjected = tinyorm_impl::ReflectionVisitor::HasInjected<C>;
+    /**
+     * @brief Times the execution of a query for the slow query log, which
+     * it reports to once the query is done. A query which is stepped in
+     * parts is timed part by part, the time between them isn't counted.
+     */
+    class SlowWatch {
+    public:
+        explicit SlowWatch(const SlowQueryLog* log) : log_(log) {}
+
+        //! Run `fn()`, which steps the query and returns the rows it read.
+        template <typename Fn>
+        inline void Time(Fn&& fn) {
+            if (!log_) {
+                fn();
+                return;
+            }
+            auto start = std::chrono::steady_clock::now();
+            rows_ += fn();
+            elapsed_ += std::chrono::steady_clock::now() - start;
+        }
 
-    template <typename Q, typename D>
-    friend class QueryResult;
-    template <typename D>
-    friend class DBManager;
+        void Done(DB& db, const tinyorm_impl::QueryClause::Rendered& query) {
+            if (!log_ || elapsed_ < log_->threshold || !log_->onSlow) return;
+            log_->onSlow(SlowQuery{
+                query.sql,
+                log_->redactValues ? tinyorm_impl::BoundValues{}
+                                   : query.values,
+                elapsed_, rows_, _Explain(db, query)});
+        }
 
-    std::shared_ptr<DB> dbhandler_;
-    Result _queryHelper;
-    std::string _sqlFrom;
-    std::string _sqlTarget;
-    std::string _sqlSelect;
-    std::string _sqlWhere;
-    std::string _sqlGroupBy;
-    std::string _sqlHaving;
-    std::string _sqlOrderBy;
-    std::string _sqlLimit;
-    std::string _sqlOffset;
+    private:
+        const SlowQueryLog* log_;
+        std::chrono::nanoseconds elapsed_{0};
+        size_t rows_ = 0;
+    };
 
-    QueryResult(std::shared_ptr<DB> db_ptr, Result queryHelper,
-                std::string sqlFrom, std::string sqlSelect = "select ",
-                std::string sqlTarget = "*",
-                std::string sqlWhere = std::string{},
-                std::string sqlGroupBy = std::string{},
-                std::string sqlHaving = std::string{},
-                std::string sqlOrderBy = std::string{},
-                std::string sqlLimit = std::string{},
-                std::string sqlOffset = std::string{})
-        : dbhandler_(db_ptr),
-          _queryHelper(queryHelper),
-          _sqlFrom(sqlFrom),
-          _sqlTarget(sqlTarget),
-          _sqlSelect(sqlSelect),
-          _sqlWhere(sqlWhere),
-          _sqlGroupBy(sqlGroupBy),
-          _sqlHaving(sqlHaving),
-          _sqlOrderBy(sqlOrderBy),
-          _sqlLimit(sqlLimit),
-          _sqlOffset(sqlOffset) {}
-
-    inline std::string _GetFromSql() const {
-        return _sqlFrom + _sqlWhere + _sqlGroupBy + _sqlHaving;
-    }
-
-    inline std::string _GetLimit() const {
-        return _sqlOrderBy + _sqlLimit + _sqlOffset;
-    }
-
-    // Select for Normal Objects
-    template <typename C, typename Out>
-    inline void _Select(const C&, Out& out) const {
-        auto copy = _queryHelper;
-        dbhandler_->ExecuteCallback(
-            _sqlSelect + _sqlTarget + _GetFromSql() + _GetLimit() + ";",
-            [&copy, &out](int argc, char** argv) {
-                tinyorm_impl::ReflectionVisitor::Visit(
-                    copy, [argc](auto&... args) {
-                        if (sizeof...(args) != argc)
-                            throw std::runtime_error(BAD_COLUMN_COUNT);
-                    });
-                tinyorm_impl::ReflectionVisitor::Visit(
-                    copy, [argv](auto&... args) {
-                        size_t idx = 0;
-                        ((tinyorm_impl::Deserializer::Deserialize(args,
-                                                                  argv[idx++])),
-                         ...);
-                    });
+    /**
+     * @brief Run `fn()`, which executes `query` and returns the number of
+     * rows, under the scan check and the slow query log.
+     */
+    template <typename Fn>
+    static inline void _Run(DB& db, const ScanCheck* check,
+                            const SlowQueryLog* log,
+                            const tinyorm_impl::QueryClause::Rendered& query,
+                            Fn&& fn) {
+        _CheckScans(db, check, query);
+        SlowWatch watch(log);
+        watch.Time(std::forward<Fn>(fn));
+        watch.Done(db, query);
+    }
+
+    template <typename Out>
+    static inline void _Select(DB& db, const std::string& sql,
+                               const tinyorm_impl::BoundValues& values,
+                               Result copy, Out& out) {
+        bool checked = false;
+        // Summed up locally, a clock read per row is all profiling costs.
+        const bool profiling = Timer::Enabled(db);
+        std::chrono::nanoseconds decoding{0};
+        db.ExecuteCallback(
+            sql, values,
+            [&copy, &out, &checked, profiling, &decoding](sqlite3_stmt* stmt) {
+                if (!checked) _CheckColumns(copy, stmt);
+                checked = true;
+                if (profiling) {
+                    auto start = std::chrono::steady_clock::now();
+                    _Decode(copy, stmt);
+                    decoding += std::chrono::steady_clock::now() - start;
+                } else {
+                    _Decode(copy, stmt);
+                }
                 out.push_back(std::move(copy));
             });
+        if (profiling) Timer::Add(db, &ProfileStats::decode, decoding);
     }
 
-    // Select for Tuples
-    template <typename Out, typename... Args>
-    inline void _Select(const std::tuple<Args...>&, Out& out) const {
-        auto copy = _queryHelper;
-        dbhandler_->ExecuteCallback(
-            _sqlSelect + _sqlTarget + _GetFromSql() + _GetLimit() + ";",
-            [&copy, &out](int argc, char** argv) {
-                if (sizeof...(Args) != argc)
-                    throw std::runtime_error(BAD_COLUMN_COUNT);
-                size_t idx = 0;
-                tinyorm_impl::QueryHelper::TupleVisit(copy, [argv,
-                                                             &idx](auto& val) {
-                    tinyorm_impl::Deserializer::Deserialize(val, argv[idx++]);
-                });
-                out.push_back(copy);
+    template <typename T>
+    static inline Nullable<T> _Aggregate(
+        DB& db, const std::string& sql,
+        const tinyorm_impl::BoundValues& values) {
+        Nullable<T> ret;
+        db.ExecuteCallback(sql, values, [&ret](sqlite3_stmt* stmt) {
+            if (sqlite3_column_count(stmt) != 1)
+                throw std::runtime_error(BAD_COLUMN_COUNT);
+            tinyorm_impl::Deserializer::Deserialize(ret, stmt, 0);
+        });
+        return ret;
+    }
+
+    //! The work of `ToVector`, runnable on any connection.
+    inline auto _SelectWork() const {
+        return [query = _Build(*dbhandler_), helper = _queryHelper,
+                check = scanCheck_,
+                log = slowLog_](const std::shared_ptr<DB>& db) {
+            std::vector<Result> ret;
+            _Run(*db, check.get(), log.get(), query, [&]() {
+                _Select(*db, query.sql, query.values, helper, ret);
+                return ret.size();
+            });
+            return ret;
+        };
+    }
+
+    //! The work of `Aggregate`, runnable on any connection.
+    template <typename T>
+    inline auto _AggregateWork(
+        const tinyorm_impl::Expression::AggregateField<T>& agg) const {
+        return [query = _Build(*dbhandler_, agg.fieldName_),
+                check = scanCheck_,
+                log = slowLog_](const std::shared_ptr<DB>& db) {
+            Nullable<T> ret;
+            _Run(*db, check.get(), log.get(), query, [&]() {
+                ret = _Aggregate<T>(*db, query.sql, query.values);
+                return size_t(1);
             });
+            return ret;
+        };
     }
 
     template <typename... Args>
     inline QueryResult<std::tuple<Args...>, DB> _NewQuery(
-        std::string sqlTarget, std::string sqlFrom,
+        tinyorm_impl::QueryClause::Ptr clauses,
         std::tuple<Args...>&& newQueryHelper) const {
-        return QueryResult<std::tuple<Args...>, DB>(
-            dbhandler_, newQueryHelper, std::move(sqlFrom), _sqlSelect,
-            std::move(sqlTarget), _sqlWhere, _sqlGroupBy, _sqlHaving,
-            _sqlOrderBy, _sqlLimit, _sqlOffset);
+        QueryResult<std::tuple<Args...>, DB> ret(
+            dbhandler_, std::move(newQueryHelper), std::move(clauses));
+        ret.executor_ = executor_;
+        ret.scanCheck_ = scanCheck_;
+        ret.slowLog_ = slowLog_;
+        return ret;
     }
 
     template <typename C>
-    inline auto _NewJoinQuery(
-        const C& queryHelper2,
-        const tinyorm_impl::Expression::RelationExpr& onExpr,
-        std::string joinStr) const {
+    inline auto _NewJoinQuery(const C& queryHelper2,
+                              tinyorm_impl::Expression::RelationExpr onExpr,
+                              std::string_view joinStr) const {
         return _NewQuery(
-            _sqlTarget,
-            _sqlFrom + std::move(joinStr) +
-                tinyorm_impl::ReflectionVisitor::TableName(queryHelper2) +
-                " on " + onExpr.ToString(),
+            tinyorm_impl::QueryClause::Join(
+                _clauses, joinStr,
+                tinyorm_impl::ReflectionVisitor::TableName<C>(),
+                std::move(onExpr)),
             tinyorm_impl::QueryHelper::JoinToTuple(_queryHelper, queryHelper2));
     }
 
     QueryResult _NewCompoundQuery(const QueryResult& queryResult,
-                                  std::string compoundStr) const {
-        auto ret = *this;
-        ret._sqlFrom = ret._GetFromSql() + std::move(compoundStr) +
-                       queryResult._sqlSelect + queryResult._sqlTarget +
-                       queryResult._GetFromSql();
-        ret._sqlWhere.clear();
-        ret._sqlGroupBy.clear();
-        ret._sqlHaving.clear();
-        return ret;
+                                  std::string_view compoundStr) const {
+        return _With(tinyorm_impl::QueryClause::Compound(
+            _clauses, compoundStr, queryResult._clauses));
     }
 
 public:
     template <typename... Args>
     inline auto Select(const Args&... args) const {
-        return _NewQuery(tinyorm_impl::QueryHelper::FieldToSql(args...),
-                         _sqlFrom,
-                         tinyorm_impl::QueryHelper::SelectToTuple(args...));
+        return _NewQuery(
+            tinyorm_impl::QueryClause::Target(
+                _clauses, tinyorm_impl::QueryHelper::FieldToSql(args...)),
+            tinyorm_impl::QueryHelper::SelectToTuple(args...));
     }
 
     inline QueryResult Distinct() const& {
-        auto ret = *this;
-        ret._sqlSelect = "select distinct ";
-        return ret;
+        return _With(tinyorm_impl::QueryClause::Distinct(_clauses));
     }
 
     inline QueryResult Distinct() && {
-        this->_sqlSelect = "select distinct ";
-        return std::move(*this);
+        return std::move(*this)._With(
+            tinyorm_impl::QueryClause::Distinct(std::move(_clauses)));
     }
 
     // Where Clause
     inline QueryResult Where(
-        const tinyorm_impl::Expression::RelationExpr& expr) const& {
-        auto ret = *this;
-        ret._sqlWhere = " where (" + expr.ToString() + ")";
-        return ret;
+        tinyorm_impl::Expression::RelationExpr expr) const& {
+        return _With(
+            tinyorm_impl::QueryClause::Where(_clauses, std::move(expr)));
     }
 
-    inline QueryResult Where(
-        const tinyorm_impl::Expression::RelationExpr& expr) && {
-        this->_sqlWhere = " where (" + expr.ToString() + ")";
-        return std::move(*this);
+    inline QueryResult Where(tinyorm_impl::Expression::RelationExpr expr) && {
+        return std::move(*this)._With(tinyorm_impl::QueryClause::Where(
+            std::move(_clauses), std::move(expr)));
+    }
+
+    //! Where clause of a static expression, bound without being rendered.
+    template <typename E, class Enable = std::enable_if_t<
+                              tinyorm_impl::Expression::IsStaticExpr<E>::value>>
+    inline QueryResult Where(const E& expr) const& {
+        return _With(tinyorm_impl::QueryClause::Where(_clauses, expr));
+    }
+
+    template <typename E, class Enable = std::enable_if_t<
+                              tinyorm_impl::Expression::IsStaticExpr<E>::value>>
+    inline QueryResult Where(const E& expr) && {
+        return std::move(*this)._With(
+            tinyorm_impl::QueryClause::Where(std::move(_clauses), expr));
     }
 
     // Limit Clause
     inline QueryResult Limit(size_t count) const& {
-        auto ret = *this;
-        ret._sqlLimit = " limit " + std::to_string(count);
-        return ret;
+        return _With(tinyorm_impl::QueryClause::Limit(_clauses, count));
     }
 
     inline QueryResult Limit(size_t count) && {
-        this->_sqlLimit = " limit " + std::to_string(count);
-        return std::move(*this);
+        return std::move(*this)._With(
+            tinyorm_impl::QueryClause::Limit(std::move(_clauses), count));
     }
 
     // Offset Clause
     inline QueryResult Offset(size_t count) const& {
-        auto ret = *this;
-        if (ret._sqlLimit.empty()) ret._sqlLimit = " limit ~0";
-        ret._sqlOffset = " offset " + std::to_string(count);
-        return ret;
+        return _With(tinyorm_impl::QueryClause::Offset(_clauses, count));
     }
 
     inline QueryResult Offset(size_t count) && {
-        if (this->_sqlLimit.empty()) this->_sqlLimit = " limit ~0";
-        this->_sqlOffset = " offset " + std::to_string(count);
-        return std::move(*this);
+        return std::move(*this)._With(
+            tinyorm_impl::QueryClause::Offset(std::move(_clauses), count));
     }
 
     // Group By Clause
     template <typename... Args>
     inline QueryResult GroupBy(const Args&... args) const& {
-        auto ret = *this;
-        ret._sqlGroupBy =
-            " group by " + tinyorm_impl::QueryHelper::FieldToSql(args...);
-        return ret;
+        return _With(tinyorm_impl::QueryClause::GroupBy(
+            _clauses, tinyorm_impl::QueryHelper::FieldToSql(args...)));
     }
 
     template <typename... Args>
     inline QueryResult GroupBy(const Args&... args) && {
-        this->_sqlGroupBy =
-            " group by " + tinyorm_impl::QueryHelper::FieldToSql(args...);
-        return std::move(*this);
+        return std::move(*this)._With(tinyorm_impl::QueryClause::GroupBy(
+            std::move(_clauses),
+            tinyorm_impl::QueryHelper::FieldToSql(args...)));
     }
 
     // Having Clause
     inline QueryResult Having(
-        const tinyorm_impl::Expression::RelationExpr& expr) const& {
-        auto ret = *this;
-        ret._sqlHaving = " having " + expr.ToString();
-        return ret;
+        tinyorm_impl::Expression::RelationExpr expr) const& {
+        return _With(
+            tinyorm_impl::QueryClause::Having(_clauses, std::move(expr)));
     }
 
-    inline QueryResult Having(
-        const tinyorm_impl::Expression::RelationExpr& expr) && {
-        this->_sqlHaving = " having " + expr.ToString();
-        return std::move(*this);
+    inline QueryResult Having(tinyorm_impl::Expression::RelationExpr expr) && {
+        return std::move(*this)._With(tinyorm_impl::QueryClause::Having(
+            std::move(_clauses), std::move(expr)));
+    }
+
+    template <typename E, class Enable = std::enable_if_t<
+                              tinyorm_impl::Expression::IsStaticExpr<E>::value>>
+    inline QueryResult Having(const E& expr) const& {
+        return _With(tinyorm_impl::QueryClause::Having(_clauses, expr));
+    }
+
+    template <typename E, class Enable = std::enable_if_t<
+                              tinyorm_impl::Expression::IsStaticExpr<E>::value>>
+    inline QueryResult Having(const E& expr) && {
+        return std::move(*this)._With(
+            tinyorm_impl::QueryClause::Having(std::move(_clauses), expr));
     }
 
     template <typename... Args>
     inline QueryResult OrderBy(const Args&... args) const& {
-        auto ret = *this;
-        if (ret._sqlOrderBy.empty())
-            ret._sqlOrderBy =
-                " order by " + tinyorm_impl::QueryHelper::FieldToSql(args...);
-        else
-            ret._sqlOrderBy +=
-                "," + tinyorm_impl::QueryHelper::FieldToSql(args...);
-        return ret;
+        return _With(tinyorm_impl::QueryClause::OrderBy(
+            _clauses, tinyorm_impl::QueryHelper::FieldToSql(args...), false));
     }
 
     template <typename... Args>
     inline QueryResult OrderBy(const Args&... args) && {
-        if (this->_sqlOrderBy.empty())
-            this->_sqlOrderBy =
-                " order by " + tinyorm_impl::QueryHelper::FieldToSql(args...);
-        else
-            this->_sqlOrderBy +=
-                "," + tinyorm_impl::QueryHelper::FieldToSql(args...);
-        return std::move(*this);
+        return std::move(*this)._With(tinyorm_impl::QueryClause::OrderBy(
+            std::move(_clauses),
+            tinyorm_impl::QueryHelper::FieldToSql(args...), false));
     }
 
     template <typename... Args>
     inline QueryResult OrderByDescending(const Args&... args) const& {
-        auto ret = std::move(this)->OrderBy(args...);
-        ret._sqlOrderBy += " desc";
-        return std::move(ret);
+        return _With(tinyorm_impl::QueryClause::OrderBy(
+            _clauses, tinyorm_impl::QueryHelper::FieldToSql(args...), true));
     }
 
     template <typename... Args>
     inline QueryResult OrderByDescending(const Args&... args) && {
-        auto ret = this->OrderBy(args...);
-        ret._sqlOrderBy += " desc";
-        return std::move(ret);
+        return std::move(*this)._With(tinyorm_impl::QueryClause::OrderBy(
+            std::move(_clauses),
+            tinyorm_impl::QueryHelper::FieldToSql(args...), true));
     }
 
     template <typename C>
@@ -1123,9 +3643,9 @@ public:
 
     template <typename C>
     inline auto Join(const C& queryHelper2,
-                     const tinyorm_impl::Expression::RelationExpr& onExpr,
+                     tinyorm_impl::Expression::RelationExpr onExpr,
                      std::enable_if_t<HasInjected<C>::value>* = nullptr) const {
-        return _NewJoinQuery(queryHelper2, onExpr, " join ");
+        return _NewJoinQuery(queryHelper2, std::move(onExpr), " join ");
     }
 
     template <typename C>
@@ -1135,10 +3655,9 @@ public:
 
     template <typename C>
     inline auto LeftJoin(
-        const C& queryHelper2,
-        const tinyorm_impl::Expression::RelationExpr& onExpr,
+        const C& queryHelper2, tinyorm_impl::Expression::RelationExpr onExpr,
         std::enable_if_t<HasInjected<C>::value>* = nullptr) const {
-        return _NewJoinQuery(queryHelper2, onExpr, " left join ");
+        return _NewJoinQuery(queryHelper2, std::move(onExpr), " left join ");
     }
 
     inline QueryResult Union(const QueryResult& queryResult) const {
@@ -1160,21 +3679,228 @@ public:
     template <typename T>
     Nullable<T> Aggregate(
         const tinyorm_impl::Expression::AggregateField<T>& agg) const {
+        auto query = _Build(*dbhandler_, agg.fieldName_);
         Nullable<T> ret;
-        dbhandler_->ExecuteCallback(
-            _sqlSelect + agg.fieldName_ + _GetFromSql() + _GetLimit() + ";",
-            [&ret](int argc, char** argv) {
-                if (argc != 1) throw std::runtime_error(BAD_COLUMN_COUNT);
-                tinyorm_impl::Deserializer::Deserialize(ret, argv[0]);
-            });
+        _Run(*dbhandler_, scanCheck_.get(), slowLog_.get(), query, [&]() {
+            ret = _Aggregate<T>(*dbhandler_, query.sql, query.values);
+            return size_t(1);
+        });
         return ret;
     }
 
+    //! Run `Aggregate` on a worker connection of the DBManager.
+    template <typename T>
+    std::future<Nullable<T>> AggregateAsync(
+        const tinyorm_impl::Expression::AggregateField<T>& agg) const {
+        return executor_->Submit(_AggregateWork(agg));
+    }
+
     std::vector<Result> ToVector() const {
         std::vector<Result> ret;
-        _Select(_queryHelper, ret);
+        auto query = _Build(*dbhandler_);
+        _Run(*dbhandler_, scanCheck_.get(), slowLog_.get(), query, [&]() {
+            _Select(*dbhandler_, query.sql, query.values, _queryHelper, ret);
+            return ret.size();
+        });
         return ret;
     }
+
+    //! The plan of the statement `ToVector` runs.
+    QueryPlan Explain() const { return _Explain(*dbhandler_, _Render()); }
+
+    //! Run `ToVector` on a worker connection of the DBManager.
+    std::future<std::vector<Result>> ToVectorAsync() const {
+        return executor_->Submit(_SelectWork());
+    }
+
+#ifdef TINYORM_HAS_COROUTINE
+    //! `co_await`-able `Aggregate` on a worker connection of the DBManager.
+    template <typename T>
+    tinyorm_impl::Awaitable<DB, Nullable<T>> AggregateAwait(
+        const tinyorm_impl::Expression::AggregateField<T>& agg) const {
+        return {executor_, _AggregateWork(agg)};
+    }
+
+    //! `co_await`-able `ToVector` on a worker connection of the DBManager.
+    tinyorm_impl::Awaitable<DB, std::vector<Result>> ToVectorAwait() const {
+        return {executor_, _SelectWork()};
+    }
+
+    /**
+     * @brief Async generator of the rows of a query, in chunks.
+     * @details Every `co_await Next()` yields the next chunk of at most
+     * `chunkSize` rows, or std::nullopt once the query is exhausted. The
+     * statement runs on a connection of its own, which the workers of the
+     * DBManager step one chunk at a time. A ConnectionPool lends it one of
+     * its connections, detached, for the life of the statement.
+     */
+    class ChunkStream {
+    public:
+        using Chunk = std::vector<Result>;
+
+        tinyorm_impl::Awaitable<DB, std::optional<Chunk>> Next() {
+            return {executor_,
+                    [executor = executor_.get(),
+                     state = state_](const std::shared_ptr<DB>&) {
+                        return state->Fetch(*executor);
+                    }};
+        }
+
+    private:
+        friend class QueryResult;
+        struct State {
+            explicit State(Result helper) : row(std::move(helper)) {}
+
+            tinyorm_impl::QueryClause::Rendered query;
+            std::shared_ptr<const ScanCheck> check;
+            std::shared_ptr<const SlowQueryLog> log;
+            SlowWatch watch{nullptr};
+            Result row;
+            size_t chunkSize = 1;
+            bool done = false;
+            std::shared_ptr<DB> db;
+            std::optional<typename DB::Statement> stmt;
+
+            std::optional<Chunk> Fetch(tinyorm_impl::Executor<DB>& executor) {
+                if (done) return std::nullopt;
+                if (!stmt) {
+                    if (!db) db = executor.Open();
+                    _CheckScans(*db, check.get(), query);
+                    if constexpr (Detachable<DB>::value)
+                        stmt.emplace(db->PrepareDetached(query.sql));
+                    else
+                        stmt.emplace(db->Prepare(query.sql));
+                    stmt->Bind(query.values);
+                    _CheckColumns(row, stmt->Get());
+                }
+                Chunk chunk;
+                watch.Time([this, &chunk]() {
+                    while (chunk.size() < chunkSize && stmt->Step()) {
+                        Timer timer(*db, &ProfileStats::decode);
+                        _Decode(row, stmt->Get());
+                        chunk.push_back(row);
+                    }
+                    return chunk.size();
+                });
+                if (chunk.size() < chunkSize) {
+                    done = true;
+                    stmt.reset();
+                    watch.Done(*db, query);
+                    db.reset();
+                }
+                if (chunk.empty()) return std::nullopt;
+                return chunk;
+            }
+        };
+        std::shared_ptr<tinyorm_impl::Executor<DB>> executor_;
+        std::shared_ptr<State> state_;
+
+        //! Checked for scans and timed on the worker, like `ToVectorAsync`.
+        ChunkStream(const QueryResult& query, size_t chunkSize)
+            : executor_(query.executor_),
+              state_(std::make_shared<State>(query._queryHelper)) {
+            auto& state = *state_;
+            state.query = query._Build(*query.dbhandler_);
+            state.check = query.scanCheck_;
+            state.log = query.slowLog_;
+            state.watch = SlowWatch(state.log.get());
+            state.chunkSize = std::max<size_t>(chunkSize, 1);
+            if constexpr (Detachable<DB>::value) state.db = query.dbhandler_;
+        }
+    };
+
+    inline ChunkStream Chunks(size_t chunkSize) const {
+        return ChunkStream(*this, chunkSize);
+    }
+#endif
+
+    /**
+     * @brief Input iterator streaming the rows of a live statement.
+     * @details All the copies of a cursor share one statement and one row
+     * buffer, which is overwritten by every step. The statement is handed
+     * back to the backend as soon as the last row has been read or the
+     * last copy of the cursor is destroyed.
+     */
+    class Cursor {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Result;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Result*;
+        using reference = Result&;
+
+        Cursor() = default;  //!< The past-the-end cursor
+        ~Cursor() = default;
+
+        inline reference operator*() const { return state_->row; }
+        inline pointer operator->() const { return &state_->row; }
+
+        inline Cursor& operator++() {
+            if (!state_->Next()) state_.reset();
+            return *this;
+        }
+
+        //! Keeps a copy of the current row, which `++` overwrites.
+        class Proxy {
+        public:
+            inline reference operator*() { return row_; }
+
+        private:
+            friend class Cursor;
+            Result row_;
+            explicit Proxy(const Result& row) : row_(row) {}
+        };
+
+        inline Proxy operator++(int) {
+            Proxy ret(state_->row);
+            ++*this;
+            return ret;
+        }
+
+        inline bool operator==(const Cursor& rhs) const {
+            return state_ == rhs.state_;
+        }
+        inline bool operator!=(const Cursor& rhs) const {
+            return state_ != rhs.state_;
+        }
+
+    private:
+        friend class QueryResult;
+        struct State {
+            std::shared_ptr<DB> db;
+            tinyorm_impl::BoundValues values;
+            std::optional<typename DB::Statement> stmt;
+            Result row;
+
+            bool Next() {
+                if (stmt->Step()) {
+                    Timer timer(*db, &ProfileStats::decode);
+                    _Decode(row, stmt->Get());
+                    return true;
+                }
+                stmt.reset();
+                return false;
+            }
+        };
+        std::shared_ptr<State> state_;
+
+        explicit Cursor(const QueryResult& query) {
+            auto rendered = query._Build(*query.dbhandler_);
+            _CheckScans(*query.dbhandler_, query.scanCheck_.get(), rendered);
+            state_ = std::make_shared<State>(
+                State{query.dbhandler_, std::move(rendered.values),
+                      std::nullopt, query._queryHelper});
+            auto& state = *state_;
+            state.stmt.emplace(state.db->Prepare(rendered.sql));
+            state.stmt->Bind(state.values);
+            _CheckColumns(state.row, state.stmt->Get());
+            if (!state.Next()) state_.reset();
+        }
+    };
+
+    //! Execute the query and stream its rows, see `Cursor`.
+    inline Cursor begin() const { return Cursor(*this); }
+    inline Cursor end() const { return Cursor(); }
 };
 
 template <typename T>
@@ -1201,6 +3927,14 @@ public:
     };
 };
 
+/**
+ * @brief How DBManager::InsertRange writes the entities.
+ */
+enum class InsertMode {
+    PerRow,    //!< One bound insert statement per entity
+    MultiRow,  //!< Multi-row VALUES statements bounded by the variable limit
+};
+
 /**
  * @todo
  */
@@ -1209,7 +3943,54 @@ class DBManager {
 private:
     template <typename C>
     using HasInjected = tinyorm_impl::ReflectionVisitor::HasInjected<C>;
+    //! Longer VALUES lists cost more to compile than they save in steps.
+    constexpr static size_t MAX_BATCH_ROWS = 128;
+    //! Same for the IN lists of GetByIds.
+    constexpr static size_t MAX_IN_KEYS = 256;
+    constexpr static size_t DEFAULT_ASYNC_WORKERS = 2;
+    template <typename T>
+    struct IsPool : std::false_type {};
+    template <typename T>
+    struct IsPool<ConnectionPool<T>> : std::true_type {};
     std::shared_ptr<DB> dbhandler_;
+    std::shared_ptr<tinyorm_impl::Executor<DB>> executor_;
+    std::shared_ptr<const ScanCheck> scanCheck_;
+    std::shared_ptr<const SlowQueryLog> slowLog_;
+
+    //! A manager bound to the connection of an async worker.
+    DBManager(std::shared_ptr<DB> db,
+              std::shared_ptr<tinyorm_impl::Executor<DB>> executor,
+              std::shared_ptr<const ScanCheck> check,
+              std::shared_ptr<const SlowQueryLog> log)
+        : dbhandler_(std::move(db)),
+          executor_(std::move(executor)),
+          scanCheck_(std::move(check)),
+          slowLog_(std::move(log)) {}
+
+    //! The workers of a pooled manager check connections out of its pool.
+    inline typename tinyorm_impl::Executor<DB>::Opener _PoolConnector() const {
+        if constexpr (IsPool<DB>::value)
+            return [pool = dbhandler_]() { return pool; };
+        else
+            return nullptr;
+    }
+
+    /**
+     * @brief Wrap `fn(DBManager&)` into work for the executor.
+     * @details The manager of the worker shares the settings of this one.
+     * Its executor is not owned, the work is queued in it and it joins its
+     * workers before it is destroyed.
+     */
+    template <typename Fn>
+    inline auto _Work(Fn&& fn) const {
+        std::shared_ptr<tinyorm_impl::Executor<DB>> executor(
+            std::shared_ptr<void>(), executor_.get());
+        return [fn = std::forward<Fn>(fn), executor, check = scanCheck_,
+                log = slowLog_](const std::shared_ptr<DB>& db) mutable {
+            DBManager dbm(db, executor, check, log);
+            return fn(dbm);
+        };
+    }
 
     template <typename... Args>
     static void _GetConstraint(
@@ -1227,89 +4008,364 @@ private:
         (GetConstraintHelper(args), ...);
     }
 
+    //! Whether a field written by an insert holds NULL.
     template <typename C>
-    static inline void _GetInsert(std::ostream& os, const C& entity,
-                                  bool withPrimaryKey) {
-        tinyorm_impl::ReflectionVisitor::Visit(
-            entity, [&os, &entity, withPrimaryKey](const auto& primaryKey,
-                                                   const auto&... args) {
-                const auto& fieldNames =
-                    tinyorm_impl::ReflectionVisitor::FieldNames(entity);
-                os << "insert into "
-                   << tinyorm_impl::ReflectionVisitor::TableName(entity) << "(";
-                bool extra_comma = false;
-                std::ostringstream osVal;  //!< Serialize field values.
-                auto serializeField = [&fieldNames, &os, &osVal, &extra_comma](
-                                          const auto& val, size_t index) {
-                    if (tinyorm_impl::Serializer::Serialize(osVal, val)) {
-                        os << fieldNames[index] << ",";
-                        osVal << ",";
-                        extra_comma = true;
-                    }
-                };
-                // insert the primary key
-                if (withPrimaryKey &&
-                    tinyorm_impl::Serializer::Serialize(osVal, primaryKey)) {
-                    os << fieldNames[0] << ",";
-                    osVal << ",";
-                    extra_comma = true;
-                }
+    static inline bool _HasNullField(const C& entity, bool withPrimaryKey) {
+        return tinyorm_impl::ReflectionVisitor::Visit(
+            entity, [withPrimaryKey](const auto& primaryKey,
+                                     const auto&... args) {
+                return (withPrimaryKey && _IsNull(primaryKey)) ||
+                       (_IsNull(args) || ...);
+            });
+    }
 
-                // insert the rest
-                size_t index = 1;
-                (serializeField(args, index++), ...);
+    template <typename T>
+    static inline bool _IsNull(const T&) {
+        return false;
+    }
 
-                if (extra_comma) {
-                    os.seekp(os.tellp() - std::streamoff(1));
-                    osVal.seekp(osVal.tellp() - std::streamoff(1));
-                } else {
-                    os << fieldNames[0];
-                    osVal << "null";
-                }
-                osVal << ");";
-                os << ") values (" << osVal.str();
+    template <typename T>
+    static inline bool _IsNull(const Nullable<T>& value) {
+        return !value.HasValue();
+    }
+
+    /**
+     * @brief Mark the columns written by inserting `entity`: all the non-null
+     * fields, and the primary key only if `withPrimaryKey`.
+     */
+    template <typename C>
+    static inline void _GetInsertMask(const C& entity, bool withPrimaryKey,
+                                      std::vector<bool>& mask) {
+        tinyorm_impl::ReflectionVisitor::Visit(
+            entity, [&mask, withPrimaryKey](const auto&... args) {
+                mask.clear();
+                (mask.push_back(!_IsNull(args)), ...);
+                mask[0] = mask[0] && withPrimaryKey;
             });
     }
 
+    //! The insert statement of `rows` entities sharing the same `mask`.
     template <typename C>
-    static inline bool _GetUpdate(std::ostream& os, const C& entity) {
-        return tinyorm_impl::ReflectionVisitor::Visit(
-            entity,
-            [&os, &entity](const auto& primaryKey, const auto&... args) {
-                if (sizeof...(args) == 0) return false;
-                const auto& fieldNames =
-                    tinyorm_impl::ReflectionVisitor::FieldNames(entity);
-                const auto& tableName =
-                    tinyorm_impl::ReflectionVisitor::TableName(entity);
-                os << "update " << tableName << " set ";
-
-                auto serializeField = [&fieldNames, &os](const auto& val,
-                                                         size_t index) {
-                    os << fieldNames[index] << "=";
-                    if (!tinyorm_impl::Serializer::Serialize(os, val))
-                        os << "null";
-                    os << ",";
-                };
-
-                size_t idx = 1;
-                (serializeField(args, idx++), ...);
-                os.seekp(os.tellp() - std::streamoff(1));
-
-                os << " where " << tableName << "." << fieldNames[0] << "=";
-                if (!tinyorm_impl::Serializer::Serialize(os, primaryKey))
-                    os << "null";
-                os << ";";
-                return true;
+    static inline std::string _GetInsertSql(const C& entity,
+                                            const std::vector<bool>& mask,
+                                            size_t rows = 1) {
+        const auto& fieldNames =
+            tinyorm_impl::ReflectionVisitor::FieldNames(entity);
+        std::string columns, values;
+        for (size_t idx = 0; idx < mask.size(); ++idx) {
+            if (!mask[idx]) continue;
+            columns.append(fieldNames[idx]) += ",";
+            values += "?,";
+        }
+        if (columns.empty()) {
+            columns = fieldNames[0];
+            values = "null";
+        } else {
+            columns.pop_back();
+            values.pop_back();
+        }
+        std::string sql = "insert into " +
+                          tinyorm_impl::ReflectionVisitor::TableName(entity) +
+                          "(" + columns + ") values ";
+        sql.reserve(sql.size() + rows * (values.size() + 3));
+        for (size_t row = 0; row < rows; ++row) {
+            if (row) sql += ",";
+            sql += "(" + values + ")";
+        }
+        return sql + ";";
+    }
+
+    /**
+     * @brief Bind the fields of `entity` marked by `mask`, starting from the
+     * placeholder after `offset`.
+     * @return the index of the last bound placeholder.
+     */
+    template <typename Stmt, typename C>
+    static inline int _BindInsert(Stmt& stmt, const C& entity,
+                                  const std::vector<bool>& mask,
+                                  int offset = 0) {
+        tinyorm_impl::ReflectionVisitor::Visit(
+            entity, [&stmt, &mask, &offset](const auto&... args) {
+                size_t idx = 0;
+                ((mask[idx++] ? stmt.Bind(++offset, args) : void()), ...);
             });
+        return offset;
     }
 
-public:
-    DBManager(const std::string& db_name)
-        : dbhandler_(std::make_shared<DB>(db_name)) {
-        dbhandler_->Execute("PRAGMA foreign_keys = ON;");
+    //! Bind the fields of `CrudSql::Update`, the primary key goes last.
+    template <typename Stmt, typename C>
+    static inline void _BindUpdate(Stmt& stmt, const C& entity) {
+        tinyorm_impl::ReflectionVisitor::Visit(
+            entity, [&stmt](const auto& primaryKey, const auto&... args) {
+                int idx = 0;
+                (stmt.Bind(++idx, args), ...);
+                stmt.Bind(++idx, primaryKey);
+            });
+    }
+
+    template <typename C>
+    using PrimaryKey = tinyorm_impl::ReflectionVisitor::PrimaryKey<C>;
+
+    //! Run a `CrudSql::Find` statement for `key`, `row` is reset if missing.
+    template <typename Stmt, typename C>
+    static inline void _FindInto(Stmt& stmt, const PrimaryKey<C>& key,
+                                 std::optional<C>& row) {
+        stmt.Bind(1, key);
+        if (!stmt.Step()) {
+            row.reset();
+            return;
+        }
+        if (!row) row.emplace();
+        QueryResult<C, DB>::_Decode(*row, stmt.Get());
+    }
+
+    //! An argument of `CreateIndex`, a bare key is in ascending order.
+    static inline const Index& _IndexArg(const Index& arg) { return arg; }
+
+    template <typename T>
+    static inline Index _IndexArg(
+        const tinyorm_impl::Expression::FieldBase<T>& field) {
+        return Index::Asc(field);
+    }
+
+    static inline Index _IndexArg(const Constraint::CompositeField& fields) {
+        return Index::Asc(fields);
+    }
+
+    /**
+     * @brief Call `fn(row)` for every entity matching one of `keys`.
+     * @details The keys are converted to the type of the primary key
+     * before they are bound, like the key of `Find`, and the converted
+     * values of a batch are kept until it is stepped.
+     */
+    template <typename C, typename In, typename Fn>
+    void _GetByIds(const In& keys, Fn&& fn) {
+        static_assert(
+            std::is_convertible_v<decltype(*std::begin(keys)), PrimaryKey<C>>,
+            "The keys must convert to the type of the primary key");
+        const size_t limit = std::clamp<size_t>(
+            std::max(dbhandler_->MaxVariableNumber(), 1), 1, MAX_IN_KEYS);
+        C row;
+        tinyorm_impl::BoundValues bound;
+        auto it = std::begin(keys);
+        auto end = std::end(keys);
+        while (it != end) {
+            bound.clear();
+            for (; it != end && bound.size() < limit; ++it)
+                bound.push_back(tinyorm_impl::Serializer::ToBound(
+                    static_cast<PrimaryKey<C>>(*it)));
+            size_t slots = 1;
+            while (slots < bound.size()) slots <<= 1;
+            slots = std::min(slots, limit);
+            std::string sql(tinyorm_impl::CrudSql::FindIn<C>());
+            for (size_t idx = 0; idx < slots; ++idx) sql += idx ? ",?" : "?";
+            sql += ");";
+            auto stmt = dbhandler_->Prepare(sql);
+            int param = 0;
+            for (const auto& value : bound) stmt.Bind(++param, value);
+            while (static_cast<size_t>(param) < slots)
+                stmt.Bind(++param, bound.back());
+            while (stmt.Step()) {
+                QueryResult<C, DB>::_Decode(row, stmt.Get());
+                fn(row);
+            }
+        }
+    }
+
+    template <typename In>
+    void _InsertRows(const In& entities, bool withPrimaryKey) {
+        std::vector<bool> mask, stmtMask;
+        std::optional<typename DB::Statement> stmt;
+        for (const auto& entity : entities) {
+            _GetInsertMask(entity, withPrimaryKey, mask);
+            if (!stmt || mask != stmtMask) {
+                stmt.reset();
+                stmt.emplace(dbhandler_->Prepare(_GetInsertSql(entity, mask)));
+                stmtMask = mask;
+            }
+            _BindInsert(*stmt, entity, mask);
+            stmt->Step();
+            stmt->Reset();
+        }
+    }
+
+    /**
+     * @brief Insert runs of entities sharing the same columns with multi-row
+     * VALUES statements.
+     * @details A batch holds as many rows as the variable limit of the
+     * backend allows, up to MAX_BATCH_ROWS. The statement of a full batch is
+     * kept for the whole run, a shorter tail batch is prepared on its own.
+     */
+    template <typename In, typename C = typename In::value_type>
+    void _InsertBatches(const In& entities, bool withPrimaryKey) {
+        const size_t maxVariables =
+            std::max(dbhandler_->MaxVariableNumber(), 1);
+        std::vector<bool> mask, batchMask;
+        std::vector<const C*> batch;
+        size_t batchRows = 0;
+        std::optional<typename DB::Statement> fullStmt;
+        auto flush = [this, &batch, &batchMask, &batchRows, &fullStmt]() {
+            if (batch.empty()) return;
+            std::optional<typename DB::Statement> tailStmt;
+            auto& stmt = batch.size() == batchRows ? fullStmt : tailStmt;
+            if (!stmt)
+                stmt.emplace(dbhandler_->Prepare(
+                    _GetInsertSql(*batch.front(), batchMask, batch.size())));
+            int param = 0;
+            for (auto entity : batch)
+                param = _BindInsert(*stmt, *entity, batchMask, param);
+            stmt->Step();
+            stmt->Reset();
+            batch.clear();
+        };
+        for (const auto& entity : entities) {
+            _GetInsertMask(entity, withPrimaryKey, mask);
+            if (batch.empty() || mask != batchMask) {
+                flush();
+                fullStmt.reset();
+                batchMask = mask;
+                size_t columns = std::count(mask.begin(), mask.end(), true);
+                batchRows = std::clamp<size_t>(
+                    maxVariables / std::max<size_t>(columns, 1), 1,
+                    MAX_BATCH_ROWS);
+            }
+            batch.push_back(&entity);
+            if (batch.size() == batchRows) flush();
+        }
+        flush();
     }
+
+public:
+    /**
+     * @brief Open the backend with `db_name` and the extra arguments.
+     * @details The workers of the async operations open their own backend
+     * with the same arguments when they start, so they need a database
+     * file rather than `:memory:`. The workers of a ConnectionPool check
+     * their connections out of this pool instead. A chunk stream, which
+     * the workers step in turn, has a connection of its own: a detached one
+     * of the pool, or a new backend otherwise.
+     */
+    template <typename... Args>
+    DBManager(const std::string& db_name, const Args&... args)
+        : dbhandler_(std::make_shared<DB>(db_name, args...)),
+          executor_(std::make_shared<tinyorm_impl::Executor<DB>>(
+              [db_name, args...]() {
+                  return std::make_shared<DB>(db_name, args...);
+              },
+              DEFAULT_ASYNC_WORKERS, _PoolConnector())) {}
     ~DBManager() = default;
 
+    /**
+     * @brief Check the queries built by `Query` for full scans of large
+     * tables, see ScanCheck. std::nullopt turns the check off.
+     * @details Queries built before the call keep their setting.
+     */
+    inline void SetScanCheck(std::optional<ScanCheck> check) {
+        scanCheck_ = check ? std::make_shared<const ScanCheck>(
+                                 std::move(*check))
+                           : nullptr;
+    }
+
+    /**
+     * @brief Log the slow queries built by `Query`, see SlowQueryLog.
+     * std::nullopt turns the log off.
+     * @details Queries built before the call keep their setting. Cursors
+     * are not timed, their rows are consumed at the pace of the caller.
+     * Chunk streams are timed while their chunks are fetched.
+     */
+    inline void SetSlowQueryLog(std::optional<SlowQueryLog> log) {
+        slowLog_ = log ? std::make_shared<const SlowQueryLog>(std::move(*log))
+                       : nullptr;
+    }
+
+    /**
+     * @brief The backend of the calling thread's operations, e.g. to read
+     * its statistics. The async workers have connections of their own.
+     */
+    inline DB& Backend() const { return *dbhandler_; }
+
+    //! Bound the number of threads running the async operations.
+    inline void SetAsyncWorkers(size_t workers) {
+        executor_->SetMaxWorkers(workers);
+    }
+
+    /**
+     * @brief Call `fn(DBManager&)` on a worker thread.
+     * @return a future of the result of `fn`.
+     * @details The manager handed to `fn` uses the connection of the worker
+     * and the settings of this manager, and must not outlive the call. Its
+     * async operations run at once on the same worker.
+     */
+    template <typename Fn>
+    auto Async(Fn&& fn) {
+        return executor_->Submit(_Work(std::forward<Fn>(fn)));
+    }
+
+    template <typename... Args>
+    inline std::future<void> InsertAsync(const Args&... args) {
+        return Async([args...](DBManager& dbm) { dbm.Insert(args...); });
+    }
+
+    template <typename... Args>
+    inline std::future<void> InsertRangeAsync(const Args&... args) {
+        return Async([args...](DBManager& dbm) { dbm.InsertRange(args...); });
+    }
+
+    template <typename... Args>
+    inline std::future<void> UpdateAsync(const Args&... args) {
+        return Async([args...](DBManager& dbm) { dbm.Update(args...); });
+    }
+
+    template <typename... Args>
+    inline std::future<void> UpdateRangeAsync(const Args&... args) {
+        return Async([args...](DBManager& dbm) { dbm.UpdateRange(args...); });
+    }
+
+    template <typename... Args>
+    inline std::future<void> DeleteAsync(const Args&... args) {
+        return Async([args...](DBManager& dbm) { dbm.Delete(args...); });
+    }
+
+#ifdef TINYORM_HAS_COROUTINE
+    /**
+     * @brief `co_await`-able `fn(DBManager&)` on a worker thread.
+     * @details The awaiting coroutine is resumed on the worker thread.
+     */
+    template <typename Fn>
+    auto Await(Fn fn) {
+        using R = std::invoke_result_t<Fn&, DBManager&>;
+        return tinyorm_impl::Awaitable<DB, R>(executor_, _Work(std::move(fn)));
+    }
+
+    template <typename... Args>
+    inline auto InsertAwait(const Args&... args) {
+        return Await([args...](DBManager& dbm) { dbm.Insert(args...); });
+    }
+
+    template <typename... Args>
+    inline auto InsertRangeAwait(const Args&... args) {
+        return Await([args...](DBManager& dbm) { dbm.InsertRange(args...); });
+    }
+
+    template <typename... Args>
+    inline auto UpdateAwait(const Args&... args) {
+        return Await([args...](DBManager& dbm) { dbm.Update(args...); });
+    }
+
+    template <typename... Args>
+    inline auto UpdateRangeAwait(const Args&... args) {
+        return Await([args...](DBManager& dbm) { dbm.UpdateRange(args...); });
+    }
+
+    template <typename... Args>
+    inline auto DeleteAwait(const Args&... args) {
+        return Await([args...](DBManager& dbm) { dbm.Delete(args...); });
+    }
+#endif
+
+    //! The effective options of the backend, e.g. Sqlite3Options.
+    inline auto Options() { return dbhandler_->Options(); }
+
     template <typename Fn>
     void Transaction(Fn&& fn) {
         try {
@@ -1335,9 +4391,10 @@ public:
                                                const auto& arg, size_t idx) {
             constexpr const char* typeStr = tinyorm_impl::TypeString<
                 std::decay_t<decltype(arg)>>::type_string;
-            fieldFixes.emplace(fieldNames[idx], typeStr);
+            std::string name(fieldNames[idx]);
+            fieldFixes.emplace(name, typeStr);
             if constexpr (!Is_Nullable<std::decay_t<decltype(arg)>>::value) {
-                fieldFixes[fieldNames[idx]] += " not null";
+                fieldFixes[name] += " not null";
             }
         };
         tinyorm_impl::ReflectionVisitor::Visit(
@@ -1346,13 +4403,14 @@ public:
                 (addTypeStr(args, idx++), ...);
             });
 
-        fieldFixes[fieldNames[0]] += " primary key";
+        fieldFixes[std::string(fieldNames[0])] += " primary key";
         std::string tableFixes;
         _GetConstraint(tableFixes, fieldFixes, cstrs...);
 
         std::string strFmt;
         for (const auto& field : fieldNames) {
-            strFmt += (field + fieldFixes[field] + ",");
+            std::string name(field);
+            strFmt += (name + fieldFixes[name] + ",");
         }
         strFmt += std::move(tableFixes);
         strFmt.pop_back();
@@ -1372,6 +4430,35 @@ public:
                             ";");
     }
 
+    /**
+     * @brief Create the index `name` on the table of `entity`.
+     * @details The arguments are the keys in order, as Field or
+     * CalculateField values, a Constraint::CompositeField, or
+     * Index::Asc/Desc, mixed with Index::Unique and Index::Where options.
+     */
+    template <typename C, typename... Args>
+    std::enable_if_t<HasInjected<C>::value> CreateIndex(
+        const C& entity, const std::string& name, const Args&... args) {
+        const auto& table = tinyorm_impl::ReflectionVisitor::TableName(entity);
+        std::string keys, where;
+        bool unique = false;
+        auto addArg = [&table, &keys, &where, &unique](const Index& arg) {
+            if (!arg.key_.empty()) (keys += arg._Key(table)) += ",";
+            if (!arg.where_.empty()) where = " where " + arg.where_;
+            unique = unique || arg.unique_;
+        };
+        (addArg(_IndexArg(args)), ...);
+        if (keys.empty()) throw std::runtime_error(NO_SUCH_FIELD);
+        keys.pop_back();
+        dbhandler_->Execute(std::string("create ") + (unique ? "unique " : "") +
+                            "index " + name + " on " + table + "(" + keys +
+                            ")" + where + ";");
+    }
+
+    inline void DropIndex(const std::string& name) {
+        dbhandler_->Execute("drop index " + name + ";");
+    }
+
     template <typename C>
     std::enable_if_t<!HasInjected<C>::value> Delete(const C&) {}
 
@@ -1380,20 +4467,12 @@ public:
      */
     template <typename C>
     std::enable_if_t<HasInjected<C>::value> Delete(const C& entity) {
-        const auto& fieldNames =
-            tinyorm_impl::ReflectionVisitor::FieldNames(entity);
-        std::ostringstream os;
-        os << "delete from "
-           << tinyorm_impl::ReflectionVisitor::TableName(entity) << " where "
-           << fieldNames[0] << "=";
+        auto stmt = dbhandler_->Prepare(tinyorm_impl::CrudSql::Delete<C>());
         tinyorm_impl::ReflectionVisitor::Visit(
-            entity, [&os](const auto& primaryKey, const auto&... dummy) {
-                if (!tinyorm_impl::Serializer::Serialize(os, primaryKey)) {
-                    os << "null";
-                }
+            entity, [&stmt](const auto& primaryKey, const auto&...) {
+                stmt.Bind(1, primaryKey);
             });
-        os << ";";
-        dbhandler_->Execute(os.str());
+        stmt.Step();
     }
 
     template <typename C>
@@ -1404,43 +4483,89 @@ public:
     std::enable_if_t<HasInjected<C>::value> Delete(
         const C& entity, const tinyorm_impl::Expression::RelationExpr& expr) {
         dbhandler_->Execute("delete from " +
-                            tinyorm_impl::ReflectionVisitor::TableName(entity) +
-                            " where " + expr.ToString() + ";");
+                                tinyorm_impl::ReflectionVisitor::TableName(
+                                    entity) +
+                                " where " + expr.ToSql() + ";",
+                            expr.Values());
     }
 
     template <typename C>
     std::enable_if_t<!HasInjected<C>::value> Insert(const C&, bool = true) {}
 
+    /**
+     * @brief Insert the entity, NULL fields are left to the column defaults.
+     * @details An entity without NULL fields uses the statement generated at
+     * compile time, the others one which only lists their non-null columns.
+     */
     template <typename C>
     std::enable_if_t<HasInjected<C>::value> Insert(const C& entity,
                                                    bool withPrimaryKey = true) {
-        std::ostringstream os;
-        _GetInsert(os, entity, withPrimaryKey);
-        dbhandler_->Execute(os.str());
+        constexpr bool hasColumns =
+            tinyorm_impl::ReflectionVisitor::FieldNames<C>().size() > 1;
+        if (!_HasNullField(entity, withPrimaryKey) &&
+            (withPrimaryKey || hasColumns)) {
+            auto stmt = dbhandler_->Prepare(
+                withPrimaryKey ? tinyorm_impl::CrudSql::Insert<C>()
+                               : tinyorm_impl::CrudSql::InsertWithoutKey<C>());
+            tinyorm_impl::ReflectionVisitor::Visit(
+                entity, [&stmt, withPrimaryKey](const auto& primaryKey,
+                                                const auto&... args) {
+                    int idx = 0;
+                    if (withPrimaryKey) stmt.Bind(++idx, primaryKey);
+                    (stmt.Bind(++idx, args), ...);
+                });
+            stmt.Step();
+            return;
+        }
+        std::vector<bool> mask;
+        _GetInsertMask(entity, withPrimaryKey, mask);
+        auto stmt = dbhandler_->Prepare(_GetInsertSql(entity, mask));
+        _BindInsert(stmt, entity, mask);
+        stmt.Step();
     }
 
     template <typename In, typename C = typename In::value_type>
-    std::enable_if_t<!HasInjected<C>::value> InsertRange(const In&, bool);
+    std::enable_if_t<!HasInjected<C>::value> InsertRange(const In&, bool,
+                                                         InsertMode);
 
+    /**
+     * @brief Insert every entity of the range inside one savepoint.
+     * @details With InsertMode::PerRow the insert statement is prepared once
+     * for each set of non-null columns and then only bound and stepped per
+     * entity. InsertMode::MultiRow packs consecutive entities with the same
+     * columns into multi-row VALUES statements.
+     */
     template <typename In, typename C = typename In::value_type>
     std::enable_if_t<HasInjected<C>::value> InsertRange(
-        const In& entities, bool withPrimaryKey = true) {
-        std::ostringstream os;
-        if (!entities.empty()) {
-            for (const auto& entity : entities) {
-                _GetInsert(os, entity, withPrimaryKey);
-            }
-            dbhandler_->Execute(os.str());
+        const In& entities, bool withPrimaryKey = true,
+        InsertMode mode = InsertMode::PerRow) {
+        if (entities.empty()) return;
+        dbhandler_->Execute("savepoint tinyorm_insert_range;");
+        try {
+            if (mode == InsertMode::MultiRow)
+                _InsertBatches(entities, withPrimaryKey);
+            else
+                _InsertRows(entities, withPrimaryKey);
+        } catch (...) {
+            dbhandler_->Execute("rollback to tinyorm_insert_range;");
+            dbhandler_->Execute("release tinyorm_insert_range;");
+            throw;
         }
+        dbhandler_->Execute("release tinyorm_insert_range;");
     }
 
     template <typename C>
     std::enable_if_t<!HasInjected<C>::value> Update(const C&) {}
 
+    /**
+     * @brief Write every field of the entity to the row of its primary key.
+     */
     template <typename C>
     std::enable_if_t<HasInjected<C>::value> Update(const C& entity) {
-        std::ostringstream os;
-        if (_GetUpdate(os, entity)) dbhandler_->Execute(os.str());
+        if (tinyorm_impl::ReflectionVisitor::FieldNames<C>().size() < 2) return;
+        auto stmt = dbhandler_->Prepare(tinyorm_impl::CrudSql::Update<C>());
+        _BindUpdate(stmt, entity);
+        stmt.Step();
     }
 
     template <typename C>
@@ -1453,26 +4578,108 @@ public:
         const C& entity,
         const tinyorm_impl::Expression::AssignmentExpr& assignClause,
         const tinyorm_impl::Expression::RelationExpr& whereClause) {
+        auto values = assignClause.Values();
+        values.insert(values.end(), whereClause.Values().begin(),
+                      whereClause.Values().end());
         dbhandler_->Execute("update " +
-                            tinyorm_impl::ReflectionVisitor::TableName(entity) +
-                            " set " + assignClause.ToString() + " where " +
-                            whereClause.ToString() + ";");
+                                tinyorm_impl::ReflectionVisitor::TableName(
+                                    entity) +
+                                " set " + assignClause.ToSql() + " where " +
+                                whereClause.ToSql() + ";",
+                            values);
     }
 
     template <typename In, typename C = typename In::value_type>
     std::enable_if_t<!HasInjected<C>::value> UpdateRange(const In&) {}
 
+    /**
+     * @brief Update every entity of the range inside one savepoint, through
+     * one prepared statement.
+     */
     template <typename In, typename C = typename In::value_type>
     std::enable_if_t<HasInjected<C>::value> UpdateRange(const In& entities) {
-        std::ostringstream os, osTmp;
-        for (const auto& entity : entities) {
-            if (_GetUpdate(osTmp, entity)) {
-                os << osTmp.str();
-                osTmp.str("");
+        if (entities.empty() ||
+            tinyorm_impl::ReflectionVisitor::FieldNames<C>().size() < 2)
+            return;
+        dbhandler_->Execute("savepoint tinyorm_update_range;");
+        try {
+            auto stmt =
+                dbhandler_->Prepare(tinyorm_impl::CrudSql::Update<C>());
+            for (const auto& entity : entities) {
+                _BindUpdate(stmt, entity);
+                stmt.Step();
+                stmt.Reset();
             }
+        } catch (...) {
+            dbhandler_->Execute("rollback to tinyorm_update_range;");
+            dbhandler_->Execute("release tinyorm_update_range;");
+            throw;
+        }
+        dbhandler_->Execute("release tinyorm_update_range;");
+    }
+
+    /**
+     * @brief Load the entity whose primary key is `key`.
+     * @details Runs the cached statement of `CrudSql::Find` and decodes the
+     * row straight into the entity, without building a query.
+     */
+    template <typename C>
+    std::enable_if_t<HasInjected<C>::value, std::optional<C>> Find(
+        const PrimaryKey<C>& key) {
+        auto stmt = dbhandler_->Prepare(tinyorm_impl::CrudSql::Find<C>());
+        std::optional<C> ret;
+        _FindInto(stmt, key, ret);
+        return ret;
+    }
+
+    /**
+     * @brief Load the entities whose primary keys are in `keys`, in the
+     * order of `keys`. Missing keys are skipped.
+     * @details All the lookups share one prepared statement.
+     */
+    template <typename C, typename In>
+    std::enable_if_t<HasInjected<C>::value, std::vector<C>> FindMany(
+        const In& keys) {
+        auto stmt = dbhandler_->Prepare(tinyorm_impl::CrudSql::Find<C>());
+        std::vector<C> ret;
+        std::optional<C> row;
+        for (const auto& key : keys) {
+            _FindInto(stmt, key, row);
+            if (row) ret.push_back(std::move(*row));
+            stmt.Reset();
         }
-        auto sql = os.str();
-        if (!sql.empty()) dbhandler_->Execute(sql);
+        return ret;
+    }
+
+    /**
+     * @brief Load the entities whose primary keys are in `keys`, in no
+     * particular order.
+     * @details The keys are sent in `in (?,...)` batches bounded by the
+     * variable limit of the backend. A short batch is padded with its last
+     * key up to a power of two, so a handful of statements serve any count.
+     * A key repeated in another batch yields its entity again.
+     */
+    template <typename C, typename In>
+    std::enable_if_t<HasInjected<C>::value, std::vector<C>> GetByIds(
+        const In& keys) {
+        std::vector<C> ret;
+        _GetByIds<C>(keys, [&ret](C& row) { ret.push_back(row); });
+        return ret;
+    }
+
+    //! `GetByIds`, keyed by primary key.
+    template <typename C, typename In>
+    std::enable_if_t<HasInjected<C>::value,
+                     std::unordered_map<PrimaryKey<C>, C>>
+    GetByIdsMap(const In& keys) {
+        std::unordered_map<PrimaryKey<C>, C> ret;
+        _GetByIds<C>(keys, [&ret](C& row) {
+            tinyorm_impl::ReflectionVisitor::Visit(
+                row, [&ret, &row](const auto& primaryKey, const auto&...) {
+                    ret.insert_or_assign(primaryKey, row);
+                });
+        });
+        return ret;
     }
 
     template <typename C>
@@ -1482,10 +4689,14 @@ public:
     template <typename C>
     std::enable_if_t<HasInjected<C>::value, QueryResult<C, DB>> Query(
         C queryHelper) {
-        return QueryResult<C, DB>(
-            dbhandler_, std::move(queryHelper),
-            std::string(" from ") +
-                tinyorm_impl::ReflectionVisitor::TableName(queryHelper));
+        QueryResult<C, DB> ret(dbhandler_, std::move(queryHelper),
+                               tinyorm_impl::QueryClause::From(
+                                   tinyorm_impl::ReflectionVisitor::TableName<
+                                       C>()));
+        ret.executor_ = executor_;
+        ret.scanCheck_ = scanCheck_;
+        ret.slowLog_ = slowLog_;
+        return ret;
     }
 };
 
@@ -1496,8 +4707,11 @@ public:
 #undef BAD_TYPE
 #undef NOT_THE_SAME_TABLE
 #undef BAD_COLUMN_COUNT
+#undef FULL_SCAN
+#undef EXECUTOR_STOPPED
 #undef CALCULATEFIELD_OPERATOR_FIELD_VALUE_GENERATOR
 #undef CALCULATEFIELD_OPERATOR_VALUE_FIELD_GENERATOR
 #undef CALCULATEFIELD_OPERATOR_FIELD_FIELD_GENERATOR
 #undef RELATION_BINARY_OPERATOR_GENERATOR
+#undef STATIC_RELATION_OPERATOR_GENERATOR
 #endif  // TINYORM_H_
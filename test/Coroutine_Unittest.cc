@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <future>
+
+#include "tinyorm.h"
+
+using namespace std;
+using namespace tinyorm;
+using namespace tinyorm_impl;
+using namespace tinyorm_impl::Expression;
+
+struct Commodity {
+    string ID;
+    int Count;
+    Nullable<double> Price;
+    REFLECTION("Commodity", ID, Count, Price);
+};
+
+//! Eagerly started coroutine, whose completion is observed by a future.
+struct Task {
+    struct promise_type {
+        std::promise<void> done;
+        Task get_return_object() { return Task{done.get_future()}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() { done.set_value(); }
+        void unhandled_exception() {
+            done.set_exception(std::current_exception());
+        }
+    };
+    std::future<void> done;
+};
+
+class CoroutineUnittest : public ::testing::Test {
+public:
+    CoroutineUnittest() : dbm(Fresh(FILE)) {
+        dbm.CreateTbl(Commodity{});
+    }
+    ~CoroutineUnittest() { std::remove(FILE); }
+
+protected:
+    static constexpr const char* FILE = "tinyorm_coroutine_unittest.db";
+    static const char* Fresh(const char* file) {
+        std::remove(file);
+        return file;
+    }
+    DBManager<Sqlite3> dbm;
+};
+
+Task Writes(DBManager<Sqlite3>& dbm, std::thread::id& resumed) {
+    Commodity c;
+    FieldExtractor field{c};
+    vector<Commodity> stock;
+    for (int i = 0; i < 100; ++i) stock.push_back({to_string(i), i, 0.5});
+    co_await dbm.InsertRangeAwait(stock);
+    Commodity unpriced{"100", 100, nullptr};
+    co_await dbm.InsertAwait(unpriced);
+    co_await dbm.UpdateAwait(c, field(c.Price) = 2.0,
+                             field(c.Count) >= 50);
+    co_await dbm.DeleteAwait(c, field(c.Count) < 10);
+
+    // Queries are named, GCC 12 mishandles temporaries in co_await operands.
+    auto priced = dbm.Query(c).Where(field(c.Price) == 2.0);
+    auto rows = co_await priced.ToVectorAwait();
+    EXPECT_EQ(rows.size(), 51);
+    auto all = dbm.Query(c);
+    auto count = co_await all.AggregateAwait(Count());
+    EXPECT_EQ(count.Value(), 91);
+
+    bool threw = false;
+    Commodity duplicated{"100", 1, 1.0};
+    try {
+        co_await dbm.InsertAwait(duplicated);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    EXPECT_TRUE(threw);
+    // The coroutine resumes on the worker which ran the work.
+    auto id = co_await dbm.Await(
+        [](DBManager<Sqlite3>&) { return std::this_thread::get_id(); });
+    resumed = std::this_thread::get_id();
+    EXPECT_EQ(id, resumed);
+}
+
+template <typename DB>
+Task Stream(DBManager<DB>& dbm, vector<size_t>& chunks) {
+    Commodity c;
+    FieldExtractor field{c};
+    auto stream = dbm.Query(c)
+                      .Where(field(c.Count) >= 10)
+                      .OrderBy(field(c.Count))
+                      .Chunks(40);
+    int expected = 10;
+    while (auto chunk = co_await stream.Next()) {
+        chunks.push_back(chunk->size());
+        for (const auto& row : *chunk) EXPECT_EQ(row.Count, expected++);
+    }
+}
+
+TEST_F(CoroutineUnittest, AwaitTest) {
+    std::thread::id resumed;
+    auto task = Writes(dbm, resumed);
+    task.done.get();
+    EXPECT_NE(resumed, std::this_thread::get_id());
+    EXPECT_EQ(dbm.Query(Commodity{}).Aggregate(Count()).Value(), 91);
+}
+
+TEST_F(CoroutineUnittest, ChunkStreamTest) {
+    vector<Commodity> stock;
+    for (int i = 0; i < 100; ++i) stock.push_back({to_string(i), i, 0.5});
+    dbm.InsertRange(stock);
+
+    vector<SlowQuery> slow;
+    dbm.SetSlowQueryLog(SlowQueryLog{0ns, [&slow](const SlowQuery& query) {
+                                         slow.push_back(query);
+                                     }});
+    vector<size_t> chunks;
+    Stream(dbm, chunks).done.get();
+    EXPECT_EQ(chunks, (vector<size_t>{40, 40, 10}));
+    // Reported once, with the rows of every chunk.
+    ASSERT_EQ(slow.size(), 1);
+    EXPECT_EQ(slow[0].rows, 90);
+
+    // The scan check applies to streams as well.
+    ScanCheck check;
+    check.maxRows = 10;
+    dbm.SetScanCheck(check);
+    chunks.clear();
+    EXPECT_THROW(Stream(dbm, chunks).done.get(), std::runtime_error);
+    EXPECT_TRUE(chunks.empty());
+}
+
+TEST_F(CoroutineUnittest, PooledChunkStreamTest) {
+    vector<Commodity> stock;
+    for (int i = 0; i < 100; ++i) stock.push_back({to_string(i), i, 0.5});
+    dbm.InsertRange(stock);
+
+    // The stream holds a detached connection of the pool.
+    DBManager<ConnectionPool<Sqlite3>> pooled(FILE, 2);
+    vector<size_t> chunks;
+    Stream(pooled, chunks).done.get();
+    EXPECT_EQ(chunks, (vector<size_t>{40, 40, 10}));
+    EXPECT_EQ(pooled.Backend().Size(), 1);
+}
@@ -9,6 +9,7 @@ using namespace tinyorm_impl;
 using namespace tinyorm_impl::Expression;
 
 unordered_map<string, string> result;
+unordered_map<string, string> params;
 
 class Student {
 public:
@@ -47,10 +48,58 @@ public:
         result[str] = cmd;
     }
 
-    void ExecuteCallback(const string& cmd,
-                         std::function<void(int, char**)> callback) {
+    void Execute(const string& cmd, const BoundValues& values) {
         Execute(cmd);
+        std::ostringstream os;
+        for (const auto& value : values) {
+            if (&value != &values.front()) os << ",";
+            Serializer::SerializeBound(os, value);
+        }
+        params[cmd.substr(0, cmd.find_first_of(' '))] = os.str();
     }
+
+    void ExecuteCallback(const string& cmd, const BoundValues& values,
+                         std::function<void(sqlite3_stmt*)>) {
+        Execute(cmd, values);
+    }
+
+    //! Every step appends its SQL and bound values to the record.
+    struct Statement {
+        string sql;
+        vector<string> values;
+
+        template <typename T>
+        void Bind(int idx, const T& value) {
+            Bind(idx, Serializer::ToBound(value));
+        }
+
+        void Bind(int idx, const BoundValue& value) {
+            std::ostringstream os;
+            Serializer::SerializeBound(os, value);
+            values.resize(idx);
+            values[idx - 1] = os.str();
+        }
+
+        bool Step() {
+            string key = sql.substr(0, sql.find_first_of(' '));
+            result[key] += sql;
+            string joined;
+            for (const auto& value : values) joined += value + ",";
+            if (!joined.empty()) joined.pop_back();
+            params[key] += "(" + joined + ")";
+            return false;
+        }
+
+        void Reset() { values.clear(); }
+
+        sqlite3_stmt* Get() const { return nullptr; }
+    };
+
+    Statement Prepare(std::string_view sql) {
+        return Statement{string(sql), {}};
+    }
+
+    int MaxVariableNumber() const { return 16; }
 };
 
 class TypeSystemUnittest : public ::testing::Test {
@@ -78,6 +127,16 @@ TEST_F(TypeSystemUnittest, ReflectionTest) {
     EXPECT_EQ(fieldNames[0], string("ID"));
     EXPECT_EQ(fieldNames[2], string("Name"));
     EXPECT_EQ(fieldNames[4], string("IsMale"));
+    // The names are split at compile time.
+    static_assert(ReflectionVisitor::FieldNames<Student>().size() == 8);
+    static_assert(ReflectionVisitor::FieldNames<Student>()[0] == "ID");
+    static_assert(ReflectionVisitor::FieldNames<Student>()[7] ==
+                  "EnglishScores");
+    static_assert(CrudSql::Delete<Student>() ==
+                  "delete from Student where ID=?;");
+    EXPECT_EQ(CrudSql::Find<Teacher>(),
+              "select ID,Name,Grade,Address,Salary from Teacher "
+              "where Teacher.ID=?;");
 
     const auto& res_1 = field(s1.ID);
     EXPECT_EQ(res_1.fieldName_, string("ID"));
@@ -114,6 +173,12 @@ TEST_F(TypeSystemUnittest, AssignmentExpressionTest) {
     EXPECT_EQ((res_5 = nullptr).ToString(), string("IsMale=null"));
     EXPECT_EQ(((res_1 = 25) && (res_2 = "Phoenix")).ToString(),
               string("Age=25,Name='Phoenix'"));
+    auto res_6 = (res_1 = 25) && (res_5 = nullptr) && (res_2 = "Phoenix");
+    EXPECT_EQ(res_6.ToSql(), string("Age=?,IsMale=?,Name=?"));
+    EXPECT_EQ(res_6.Values().size(), 3);
+    EXPECT_EQ(std::get<long long>(res_6.Values()[0]), 25);
+    EXPECT_TRUE(std::holds_alternative<std::nullptr_t>(res_6.Values()[1]));
+    EXPECT_EQ(std::get<string>(res_6.Values()[2]), string("Phoenix"));
 }
 
 TEST_F(TypeSystemUnittest, RelationExpressionTest) {
@@ -152,6 +217,129 @@ TEST_F(TypeSystemUnittest, RelationExpressionTest) {
               string("Student.MathScores is null"));
     EXPECT_EQ((s1_math != nullptr).ToString(),
               string("Student.MathScores is not null"));
+
+    auto expr_1 = s1_Age > 20 && (s1_Name == string("Jack") || s1_math < 60);
+    auto expr_2 = s1_Age > 30 && (s1_Name == string("Rose") || s1_math < 90);
+    EXPECT_EQ(expr_1.ToSql(), string("(Student.Age>? and (Student.Name=? or "
+                                     "Student.MathScores<?))"));
+    EXPECT_EQ(expr_1.ToSql(), expr_2.ToSql());
+    EXPECT_EQ(expr_1.Values().size(), 3);
+    EXPECT_EQ(std::get<long long>(expr_2.Values()[0]), 30);
+    EXPECT_EQ(std::get<string>(expr_2.Values()[1]), string("Rose"));
+    EXPECT_EQ(std::get<long long>(expr_2.Values()[2]), 90);
+
+    // Combining a named expression leaves it unchanged.
+    auto expr_3 = expr_1 || expr_2;
+    auto expr_4 = expr_1 && s1_Age != 25;
+    EXPECT_EQ(expr_1.ToString(), string("(Student.Age>20 and (Student.Name="
+                                        "'Jack' or Student.MathScores<60))"));
+    EXPECT_EQ(expr_3.Values().size(), 6);
+    EXPECT_EQ(expr_3.ToSql(), "(" + expr_1.ToSql() + " or " +
+                                  expr_2.ToSql() + ")");
+    EXPECT_EQ(expr_4.ToString(), "(" + expr_1.ToString() +
+                                     " and Student.Age!=25)");
+
+    auto chain = s1_Age > 0;
+    string chain_str = "Student.Age>0";
+    for (int i = 1; i < 50; ++i) {
+        chain = std::move(chain) && s1_Age != i;
+        chain_str = "(" + chain_str + " and Student.Age!=" +
+                    std::to_string(i) + ")";
+    }
+    EXPECT_EQ(chain.ToString(), chain_str);
+    EXPECT_EQ(chain.Values().size(), 50);
+}
+
+TEST_F(TypeSystemUnittest, StaticExpressionTest) {
+    auto age = field.Static(s1.Age);
+    auto name = field.Static(s1.Name);
+    auto math = field.Static(s1.MathScores);
+    auto expr_1 = age > 20 && (name == string("Jack") || math < 60);
+    static_assert(decltype(expr_1)::ARITY == 3);
+    EXPECT_EQ(expr_1.ToSql(), string("(Student.Age>? and (Student.Name=? or "
+                                     "Student.MathScores<?))"));
+    EXPECT_EQ(expr_1.ToString(), string("(Student.Age>20 and (Student.Name="
+                                        "'Jack' or Student.MathScores<60))"));
+    EXPECT_EQ(expr_1.ToSql(), RelationExpr(expr_1).ToSql());
+    EXPECT_EQ(std::get<string>(expr_1.Values()[1]), string("Jack"));
+
+    // The shape is rendered once per type, unless the columns change.
+    auto expr_2 = age > 30 && (name == string("Rose") || math < 90);
+    auto shape = Shape(expr_1);
+    EXPECT_EQ(shape, Shape(expr_2));
+    EXPECT_EQ(*shape, expr_1.ToSql());
+    auto science = field.Static(s1.ScienceScores);
+    auto expr_3 = age > 30 && (name == string("Rose") || science < 90);
+    EXPECT_NE(shape, Shape(expr_3));
+    EXPECT_EQ(*Shape(expr_3), expr_3.ToSql());
+
+    EXPECT_EQ((math == science).ToSql(),
+              string("Student.MathScores=Student.ScienceScores"));
+    EXPECT_EQ((field.Static(s1.IsMale) == nullptr).ToSql(),
+              string("Student.IsMale is null"));
+    EXPECT_EQ((name & "Ja%").ToString(), string("Student.Name like 'Ja%'"));
+
+    dbm.Query(Student{}).Where(expr_2).Limit(1).ToVector();
+    EXPECT_EQ(result.at("select"),
+              "select * from Student where (" + *shape + ") limit 1;");
+    EXPECT_EQ(params.at("select"), string("30,'Rose',90"));
+    dbm.Delete(s1, age > 20);
+    EXPECT_EQ(result.at("delete"), "delete from Student where Student.Age>?;");
+    EXPECT_EQ(params.at("delete"), string("20"));
+    result.clear();
+    params.clear();
+}
+
+//! Reflected without a default constructor, and counting its objects.
+struct Ledger {
+    explicit Ledger(int id) : ID(id) { ++constructed; }
+    int ID;
+    string Owner;
+    inline static int constructed = 0;
+    REFLECTION("Ledger", ID, Owner);
+};
+
+TEST_F(TypeSystemUnittest, MemberColumnTest) {
+    EXPECT_EQ(Col(&Ledger::Owner).name, string("Owner"));
+    EXPECT_EQ(*Col(&Ledger::ID).table, string("Ledger"));
+    EXPECT_EQ(Ledger::constructed, 0);
+
+    auto age = Col(&Student::Age);
+    EXPECT_EQ(age.name, string("Age"));
+    EXPECT_EQ(*age.table, string("Student"));
+    EXPECT_EQ(Col(&Student::IsMale).name, string("IsMale"));
+    EXPECT_EQ(Col(&Teacher::Salary).name, string("Salary"));
+    static_assert(std::is_same_v<decltype(Col(&Teacher::Salary)),
+                                 Expression::Column<double>>);
+
+    auto expr = Col(&Student::Age) > 20 &&
+                Col(&Student::Grade) == field.Static(t1.Grade);
+    EXPECT_EQ(expr.ToSql(),
+              string("(Student.Age>? and Student.Grade=Teacher.Grade)"));
+    EXPECT_EQ(Shape(expr), Shape(age > 30 && Col(&Student::Grade) ==
+                                                   Col(&Teacher::Grade)));
+
+    dbm.Query(Student{})
+        .Select(Col(&Student::Name), Max(Col(&Student::MathScores)))
+        .Where(Col(&Student::Name) & "J%")
+        .GroupBy(Col(&Student::Grade))
+        .OrderBy(Col(&Student::Name))
+        .ToVector();
+    EXPECT_EQ(result.at("select"),
+              "select Student.Name,max(Student.MathScores) from Student "
+              "where (Student.Name like ?) group by Student.Grade "
+              "order by Student.Name;");
+    dbm.Update(s1, Col(&Student::Age) = 30, Col(&Student::ID) == s1.ID);
+    EXPECT_EQ(result.at("update"),
+              "update Student set Age=? where Student.ID=?;");
+    EXPECT_EQ(params.at("update"), string("30,'0001'"));
+
+    // FieldExtractor only knows the objects it was built from.
+    FieldExtractor other{t1};
+    EXPECT_THROW(other(s1.Age), std::runtime_error);
+    EXPECT_EQ(other(t1.Salary).fieldName_, string("Salary"));
+    result.clear();
+    params.clear();
 }
 
 TEST_F(TypeSystemUnittest, CalculationExpressionTest) {
@@ -214,40 +402,97 @@ TEST_F(TypeSystemUnittest, DBManagerTest) {
     dbm.DropTbl(s1);
     string drop_str = "drop table Student;";
     EXPECT_EQ(result.at("drop"), drop_str);
-    string delete_str = "delete from Student where ID='0001';";
+    dbm.CreateIndex(s1, "Student_Age", field(s1.Age));
+    EXPECT_EQ(result.at("create"),
+              string("create index Student_Age on Student(Age);"));
+    dbm.CreateIndex(s1, "Student_Scores", Index::Unique(),
+                    Index::Desc(field(s1.MathScores)),
+                    field(s1.MathScores) + field(s1.EnglishScores),
+                    Index::Where(field(s1.Grade) == string("2-nd") &&
+                                 field(s1.IsMale) != nullptr));
+    EXPECT_EQ(result.at("create"),
+              string("create unique index Student_Scores on Student("
+                     "MathScores desc,(MathScores+EnglishScores)) "
+                     "where (Grade='2-nd' and IsMale is not null);"));
+    EXPECT_THROW(dbm.CreateIndex(s1, "Teacher_Name", field(t1.Name)),
+                 std::runtime_error);
+    dbm.DropIndex("Student_Age");
+    EXPECT_EQ(result.at("drop"), string("drop index Student_Age;"));
+    string delete_str = "delete from Student where ID=?;";
     dbm.Delete(s1);
     EXPECT_EQ(result.at("delete"), delete_str);
+    EXPECT_EQ(params.at("delete"), string("('0001')"));
     result.erase("delete");
     dbm.Delete(s1, field(s1.Age) > 20);
-    delete_str = "delete from Student where Student.Age>20;";
+    delete_str = "delete from Student where Student.Age>?;";
     EXPECT_EQ(result.at("delete"), delete_str);
+    EXPECT_EQ(params.at("delete"), string("20"));
+    EXPECT_FALSE(dbm.Find<Student>("0001").has_value());
+    EXPECT_EQ(result.at("select"),
+              "select ID,Age,Name,Grade,IsMale,MathScores,ScienceScores,"
+              "EnglishScores from Student where Student.ID=?;");
+    EXPECT_EQ(params.at("select"), string("('0001')"));
+    result.erase("select");
+    params.erase("select");
+
+    // The limit of the dummy is 16 variables, the tail of 3 is padded to 4.
+    vector<string> keys;
+    for (int i = 0; i < 19; ++i) keys.push_back(std::to_string(i));
+    dbm.GetByIds<Student>(keys);
+    string find_in =
+        "select ID,Age,Name,Grade,IsMale,MathScores,ScienceScores,"
+        "EnglishScores from Student where Student.ID in (";
+    EXPECT_EQ(result.at("select"),
+              find_in + "?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?);" + find_in +
+                  "?,?,?,?);");
+    EXPECT_EQ(params.at("select"),
+              string("('0','1','2','3','4','5','6','7','8','9','10','11','12',"
+                     "'13','14','15')('16','17','18','18')"));
+    result.erase("select");
+    params.erase("select");
     string insert_str =
         "insert into Student("
         "ID,Age,Name,Grade,MathScores,"
-        "ScienceScores,EnglishScores) values ("
-        "'0001',22,'Jack','2-nd',95,97,90);";
+        "ScienceScores,EnglishScores) values (?,?,?,?,?,?,?);";
     dbm.Insert(s1);
     EXPECT_EQ(result.at("insert"), insert_str);
+    EXPECT_EQ(params.at("insert"),
+              string("('0001',22,'Jack','2-nd',95,97,90)"));
+    result.erase("insert");
+    params.erase("insert");
+    s1.IsMale = true;
+    insert_str =
+        "insert into Student(ID,Age,Name,Grade,IsMale,MathScores,"
+        "ScienceScores,EnglishScores) values (?,?,?,?,?,?,?,?);";
+    dbm.Insert(s1);
+    EXPECT_EQ(result.at("insert"), insert_str);
+    EXPECT_EQ(params.at("insert"),
+              string("('0001',22,'Jack','2-nd',1,95,97,90)"));
+    s1.IsMale = nullptr;
 
     string update_str =
         "update Student "
-        "set Age=24,Name='Narutal',Grade='1-st',IsMale=null,"
-        "MathScores=60,ScienceScores=60,EnglishScores=60 "
-        "where Student.ID='0002';";
+        "set Age=?,Name=?,Grade=?,IsMale=?,"
+        "MathScores=?,ScienceScores=?,EnglishScores=? "
+        "where Student.ID=?;";
     Student s2{"0002", 24, "Narutal", "1-st", nullptr, 60, 60, 60};
     dbm.Update(s2);
     EXPECT_EQ(result.at("update"), update_str);
+    EXPECT_EQ(params.at("update"),
+              string("(24,'Narutal','1-st',null,60,60,60,'0002')"));
     result.erase("update");
     update_str =
         "update Student "
-        "set Age=27,Name='Phoenix',Grade='3-th',IsMale=1 "
-        "where Student.ID='0001';";
+        "set Age=?,Name=?,Grade=?,IsMale=? "
+        "where Student.ID=?;";
     dbm.Update(s1,
                (field(s1.Age) = 27) && (field(s1.Name) = "Phoenix") &&
                    (field(s1.Grade) = "3-th") && (field(s1.IsMale) = 1),
                (field(s1.ID) == string("0001")));
     EXPECT_EQ(result.at("update"), update_str);
+    EXPECT_EQ(params.at("update"), string("27,'Phoenix','3-th',1,'0001'"));
     result.clear();
+    params.clear();
 }
 
 TEST_F(TypeSystemUnittest, RangeOperationTest) {
@@ -256,14 +501,56 @@ TEST_F(TypeSystemUnittest, RangeOperationTest) {
     string insert_str =
         "insert into Student("
         "ID,Age,Name,Grade,IsMale,MathScores,"
-        "ScienceScores,EnglishScores) values ("
-        "'0003',21,'Rose','1-st',0,90,92,93);"
+        "ScienceScores,EnglishScores) values (?,?,?,?,?,?,?,?);"
         "insert into Student("
         "ID,Age,Name,Grade,MathScores,"
-        "ScienceScores,EnglishScores) values ("
-        "'0004',25,'Dick','3-th',92,93,94);";
+        "ScienceScores,EnglishScores) values (?,?,?,?,?,?,?);";
+    result.clear();
+    params.clear();
     dbm.InsertRange(vec);
     EXPECT_EQ(result.at("insert"), insert_str);
+    EXPECT_EQ(params.at("insert"),
+              string("('0003',21,'Rose','1-st',0,90,92,93)"
+                     "('0004',25,'Dick','3-th',92,93,94)"));
+    EXPECT_EQ(result.at("savepoint"), "savepoint tinyorm_insert_range;");
+    EXPECT_EQ(result.at("release"), "release tinyorm_insert_range;");
+
+    result.clear();
+    params.clear();
+    dbm.InsertRange(vec, false);
+    EXPECT_EQ(result.at("insert"),
+              string("insert into Student("
+                     "Age,Name,Grade,IsMale,MathScores,"
+                     "ScienceScores,EnglishScores) values (?,?,?,?,?,?,?);"
+                     "insert into Student("
+                     "Age,Name,Grade,MathScores,"
+                     "ScienceScores,EnglishScores) values (?,?,?,?,?,?);"));
+
+    vector<Student> batch = {{"0005", 20, "Amy", "1-st", true, 80, 81, 82},
+                             {"0006", 20, "Bob", "1-st", false, 83, 84, 85},
+                             {"0007", 20, "Eve", "1-st", true, 86, 87, 88},
+                             {"0008", 20, "Tom", "1-st", nullptr, 89, 90, 91}};
+    result.clear();
+    params.clear();
+    dbm.InsertRange(batch, true, InsertMode::MultiRow);
+    EXPECT_EQ(result.at("insert"),
+              string("insert into Student("
+                     "ID,Age,Name,Grade,IsMale,MathScores,"
+                     "ScienceScores,EnglishScores) values "
+                     "(?,?,?,?,?,?,?,?),(?,?,?,?,?,?,?,?);"
+                     "insert into Student("
+                     "ID,Age,Name,Grade,IsMale,MathScores,"
+                     "ScienceScores,EnglishScores) values (?,?,?,?,?,?,?,?);"
+                     "insert into Student("
+                     "ID,Age,Name,Grade,MathScores,"
+                     "ScienceScores,EnglishScores) values (?,?,?,?,?,?,?);"));
+    EXPECT_EQ(params.at("insert"),
+              string("('0005',20,'Amy','1-st',1,80,81,82,"
+                     "'0006',20,'Bob','1-st',0,83,84,85)"
+                     "('0007',20,'Eve','1-st',1,86,87,88)"
+                     "('0008',20,'Tom','1-st',89,90,91)"));
+    EXPECT_EQ(result.at("release"), "release tinyorm_insert_range;");
+
     vec[0].Age = 24;
     vec[0].Name = "Narutal";
     vec[0].IsMale = true;
@@ -279,15 +566,18 @@ TEST_F(TypeSystemUnittest, RangeOperationTest) {
     vec[1].EnglishScores = 100;
     string update_str =
         "update Student "
-        "set Age=24,Name='Narutal',Grade='1-st',IsMale=1,"
-        "MathScores=60,ScienceScores=60,EnglishScores=60 "
-        "where Student.ID='0003';"
-        "update Student "
-        "set Age=27,Name='Phoenix',Grade='3-th',IsMale=1,"
-        "MathScores=100,ScienceScores=100,EnglishScores=100 "
-        "where Student.ID='0004';";
+        "set Age=?,Name=?,Grade=?,IsMale=?,"
+        "MathScores=?,ScienceScores=?,EnglishScores=? "
+        "where Student.ID=?;";
+    result.erase("update");
+    params.erase("update");
     dbm.UpdateRange(vec);
-    EXPECT_EQ(result.at("update"), update_str);
+    EXPECT_EQ(result.at("update"), update_str + update_str);
+    EXPECT_EQ(params.at("update"),
+              string("(24,'Narutal','1-st',1,60,60,60,'0003')"
+                     "(27,'Phoenix','3-th',1,100,100,100,'0004')"));
+    EXPECT_EQ(result.at("savepoint"), "savepoint tinyorm_update_range;");
+    EXPECT_EQ(result.at("release"), "release tinyorm_update_range;");
 }
 
 TEST_F(TypeSystemUnittest, QueryTest) {
@@ -296,7 +586,7 @@ TEST_F(TypeSystemUnittest, QueryTest) {
     EXPECT_EQ(result.at("select"), select_sql);
     select_sql =
         "select Student.MathScores,Student.ScienceScores,Student.EnglishScores "
-        "from Student where (Student.ID='0001');";
+        "from Student where (Student.ID=?);";
     dbm.Query(Student{})
         .Select(field(s1.MathScores), field(s1.ScienceScores),
                 field(s1.EnglishScores))
@@ -306,7 +596,7 @@ TEST_F(TypeSystemUnittest, QueryTest) {
 
     select_sql =
         "select Student.MathScores,Student.ScienceScores,Student.EnglishScores "
-        "from Student where (Student.ID='0001') limit 10 offset 3;";
+        "from Student where (Student.ID=?) limit 10 offset 3;";
     dbm.Query(Student{})
         .Select(field(s1.MathScores), field(s1.ScienceScores),
                 field(s1.EnglishScores))
@@ -315,6 +605,7 @@ TEST_F(TypeSystemUnittest, QueryTest) {
         .Offset(3)
         .ToVector();
     EXPECT_EQ(result.at("select"), select_sql);
+    EXPECT_EQ(params.at("select"), string("'0001'"));
 
     select_sql =
         "select Student.MathScores,Student.ScienceScores,Student.EnglishScores "
@@ -329,9 +620,9 @@ TEST_F(TypeSystemUnittest, QueryTest) {
     select_sql =
         "select Student.MathScores,Student.ScienceScores,Student.EnglishScores "
         "from Student group by Student.Grade,Student.IsMale having "
-        "(sum(Student.MathScores)>=75 "
+        "(sum(Student.MathScores)>=? "
         "and "
-        "(Student.Grade='1-st' or Student.Grade='2-nd'));";
+        "(Student.Grade=? or Student.Grade=?));";
     dbm.Query(Student{})
         .Select(field(s1.MathScores), field(s1.ScienceScores),
                 field(s1.EnglishScores))
@@ -341,6 +632,7 @@ TEST_F(TypeSystemUnittest, QueryTest) {
                  field(s1.Grade) == string("2-nd")))
         .ToVector();
     EXPECT_EQ(result.at("select"), select_sql);
+    EXPECT_EQ(params.at("select"), string("75,'1-st','2-nd'"));
 
     select_sql =
         "select * from Student order by Student.MathScores,Student.Age;";
@@ -355,6 +647,24 @@ TEST_F(TypeSystemUnittest, QueryTest) {
         .OrderByDescending(field(s1.MathScores), field(s1.Age))
         .ToVector();
     EXPECT_EQ(result.at("select"), select_sql);
+
+    // Queries derived from the same one don't see each other's clauses.
+    const auto base =
+        dbm.Query(Student{}).Where(field(s1.Age) > 20).OrderBy(field(s1.Age));
+    const auto paged = base.Limit(10).Offset(20);
+    base.OrderByDescending(field(s1.Name)).Limit(5).ToVector();
+    EXPECT_EQ(result.at("select"),
+              "select * from Student where (Student.Age>?) "
+              "order by Student.Age,Student.Name desc limit 5;");
+    paged.ToVector();
+    EXPECT_EQ(result.at("select"),
+              "select * from Student where (Student.Age>?) "
+              "order by Student.Age limit 10 offset 20;");
+    base.Offset(3).ToVector();
+    EXPECT_EQ(result.at("select"),
+              "select * from Student where (Student.Age>?) "
+              "order by Student.Age limit ~0 offset 3;");
+    EXPECT_EQ(params.at("select"), string("20"));
 }
 
 TEST_F(TypeSystemUnittest, InterTableSelect) {
@@ -370,7 +680,7 @@ TEST_F(TypeSystemUnittest, InterTableSelect) {
         "Teacher.Name,sum(((Student.MathScores+Student.EnglishScores)+Student."
         "ScienceScores)) "
         "from Student join Teacher on Student.Grade=Teacher.Grade "
-        "where (Student.Grade='3-th');";
+        "where (Student.Grade=?);";
     dbm.Query(Student{})
         .Join(Teacher{}, field(s1.Grade) == field(t1.Grade))
         .Select(field(t1.Name),
@@ -379,6 +689,7 @@ TEST_F(TypeSystemUnittest, InterTableSelect) {
         .Where(field(s1.Grade) == string("3-th"))
         .ToVector();
     EXPECT_EQ(result.at("select"), join_str);
+    EXPECT_EQ(params.at("select"), string("'3-th'"));
 
     join_str =
         "select * from Teacher left join Student on "
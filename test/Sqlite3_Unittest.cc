@@ -0,0 +1,741 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <future>
+
+#include "tinyorm.h"
+
+using namespace std;
+using namespace tinyorm;
+using namespace tinyorm_impl;
+using namespace tinyorm_impl::Expression;
+
+struct Commodity {
+    string ID;
+    int Count;
+    Nullable<double> Price;
+    REFLECTION("Commodity", ID, Count, Price);
+};
+
+class Sqlite3Unittest : public ::testing::Test {
+public:
+    Sqlite3Unittest() : db(":memory:") {
+        db.Execute("create table T(id integer primary key, name text);");
+    }
+    ~Sqlite3Unittest() = default;
+
+protected:
+    Sqlite3 db;
+
+    size_t CountRows(const string& sql) {
+        size_t rows = 0;
+        db.ExecuteCallback(sql, [&rows](int, char**) { ++rows; });
+        return rows;
+    }
+};
+
+TEST_F(Sqlite3Unittest, StatementCacheTest) {
+    auto before = db.CacheStats();
+    db.Execute("insert into T values (1, 'Jack');");
+    db.Execute("insert into T values (2, 'Rose');");
+    EXPECT_EQ(CountRows("select * from T;"), 2);
+    EXPECT_EQ(CountRows("select * from T;"), 2);
+    EXPECT_EQ(CountRows("select * from T;"), 2);
+    EXPECT_EQ(db.CacheStats().misses - before.misses, 3);
+    EXPECT_EQ(db.CacheStats().hits - before.hits, 2);
+
+    // A script is run statement by statement and is never cached.
+    auto size = db.CacheSize();
+    db.Execute(
+        "insert into T values (3, 'Dick');insert into T values (4, 'Jane');");
+    EXPECT_EQ(db.CacheSize(), size);
+    EXPECT_EQ(CountRows("select * from T;"), 4);
+    EXPECT_THROW(db.Prepare("select 1;select 2;"), std::runtime_error);
+    EXPECT_THROW(db.Execute("select * from NoSuchTable;"), std::runtime_error);
+}
+
+TEST_F(Sqlite3Unittest, StatementCacheEvictionTest) {
+    Sqlite3 small(":memory:", 2);
+    small.Execute("select 1;");
+    small.Execute("select 2;");
+    small.Execute("select 1;");
+    small.Execute("select 3;");  // evicts `select 2;`
+    EXPECT_EQ(small.CacheSize(), 2);
+    EXPECT_EQ(small.CacheStats().evictions, 1);
+    small.Execute("select 1;");
+    EXPECT_EQ(small.CacheStats().hits, 2);
+    small.Execute("select 2;");
+    EXPECT_EQ(small.CacheStats().misses, 4);
+}
+
+TEST_F(Sqlite3Unittest, StatementLeaseTest) {
+    db.Execute("insert into T values (1, 'Jack');");
+    auto outer = db.Prepare("select * from T;");
+    ASSERT_EQ(sqlite3_step(outer.Get()), SQLITE_ROW);
+    // The same SQL text is leased twice, the second lease is not cached.
+    EXPECT_EQ(CountRows("select * from T;"), 1);
+    EXPECT_EQ(CountRows("select * from T;"), 1);
+    EXPECT_EQ(db.CacheSize(), 3);
+}
+
+TEST_F(Sqlite3Unittest, DBManagerTest) {
+    DBManager<Sqlite3> dbm(":memory:");
+    Commodity c;
+    FieldExtractor field{c};
+    dbm.CreateTbl(c);
+    dbm.InsertRange(vector<Commodity>{{"001", 1, 2.5}, {"002", 2, nullptr}});
+    for (int i = 0; i < 3; ++i) {
+        auto res = dbm.Query(Commodity{})
+                       .Where(field(c.Count) >= 2)
+                       .ToVector();
+        ASSERT_EQ(res.size(), 1);
+        EXPECT_EQ(res[0].ID, string("002"));
+        EXPECT_TRUE(res[0].Price == nullptr);
+    }
+    auto sum = dbm.Query(Commodity{}).Aggregate(Sum(field(c.Count)));
+    EXPECT_EQ(sum.Value(), 3);
+}
+
+TEST_F(Sqlite3Unittest, FindTest) {
+    DBManager<Sqlite3> dbm(":memory:");
+    dbm.CreateTbl(Commodity{});
+    dbm.InsertRange(vector<Commodity>{
+        {"001", 1, 2.5}, {"002", 2, nullptr}, {"003", 3, 7.0}});
+    auto found = dbm.Find<Commodity>("002");
+    ASSERT_TRUE(found.has_value());
+    EXPECT_EQ(found->Count, 2);
+    EXPECT_TRUE(found->Price == nullptr);
+    EXPECT_FALSE(dbm.Find<Commodity>("004").has_value());
+
+    auto many = dbm.FindMany<Commodity>(vector<string>{"003", "004", "001"});
+    ASSERT_EQ(many.size(), 2);
+    EXPECT_EQ(many[0].ID, string("003"));
+    EXPECT_EQ(many[0].Price.Value(), 7.0);
+    EXPECT_EQ(many[1].ID, string("001"));
+    EXPECT_EQ(many[1].Count, 1);
+    EXPECT_TRUE(dbm.FindMany<Commodity>(vector<string>{}).empty());
+}
+
+TEST_F(Sqlite3Unittest, GetByIdsTest) {
+    DBManager<Sqlite3> dbm(":memory:");
+    dbm.CreateTbl(Commodity{});
+    vector<Commodity> rows;
+    vector<string> keys;
+    for (int i = 0; i < 600; ++i) {
+        rows.push_back({to_string(1000 + i), i, nullptr});
+        if (i % 2) keys.push_back(to_string(1000 + i));
+    }
+    dbm.InsertRange(rows);
+    keys.push_back("missing");
+    keys.push_back("1001");
+
+    // 302 keys take a batch of 256 and one of 46 padded to 64. "1001" is
+    // in both of them, so it is found twice.
+    auto found = dbm.GetByIds<Commodity>(keys);
+    EXPECT_EQ(found.size(), 301);
+    for (const auto& row : found) EXPECT_EQ(row.Count % 2, 1);
+    auto byId = dbm.GetByIdsMap<Commodity>(keys);
+    ASSERT_EQ(byId.size(), 300);
+    EXPECT_EQ(byId.at("1599").Count, 599);
+    EXPECT_EQ(byId.count("missing"), 0);
+    EXPECT_TRUE(dbm.GetByIds<Commodity>(vector<string>{}).empty());
+
+    // Keys of another type are converted, like the key of Find.
+    auto converted = dbm.GetByIdsMap<Commodity>(
+        vector<const char*>{"1001", "missing", "1003"});
+    EXPECT_EQ(converted.size(), 2);
+    EXPECT_EQ(converted.at("1003").Count, 3);
+}
+
+TEST_F(Sqlite3Unittest, ExplainTest) {
+    DBManager<Sqlite3> dbm(":memory:");
+    Commodity c;
+    FieldExtractor field{c};
+    dbm.CreateTbl(c);
+    vector<Commodity> rows;
+    for (int i = 0; i < 10; ++i) rows.push_back({to_string(i), i, nullptr});
+    dbm.InsertRange(rows);
+
+    auto byCount = dbm.Query(Commodity{}).Where(field(c.Count) == 3);
+    auto plan = byCount.Explain();
+    ASSERT_EQ(plan.steps.size(), 1);
+    EXPECT_EQ(plan.ScannedTables(), vector<string>{"Commodity"});
+    EXPECT_EQ(plan.ToString(), "QUERY PLAN\n`--" + plan.steps[0].detail + "\n");
+    auto byId = dbm.Query(Commodity{}).Where(field(c.ID) == string("3"));
+    EXPECT_TRUE(byId.Explain().ScannedTables().empty());
+
+    vector<string> scans;
+    ScanCheck check{10, [&scans](const string& table, const string&) {
+                        scans.push_back(table);
+                    }};
+    dbm.SetScanCheck(check);
+    auto query = dbm.Query(Commodity{}).Where(field(c.Count) == 3);
+    EXPECT_EQ(query.ToVector().size(), 1);
+    EXPECT_TRUE(scans.empty());
+    dbm.Insert(Commodity{"10", 10, nullptr});
+    EXPECT_EQ(query.ToVector().size(), 1);
+    query.Aggregate(Count(field(c.Count)));
+    EXPECT_EQ(scans, (vector<string>{"Commodity", "Commodity"}));
+    dbm.Query(Commodity{}).Where(field(c.ID) == string("3")).ToVector();
+    EXPECT_EQ(scans.size(), 2);
+
+    check.onScan = nullptr;
+    dbm.SetScanCheck(check);
+    EXPECT_THROW(dbm.Query(Commodity{}).ToVector(), runtime_error);
+    EXPECT_THROW(dbm.Query(Commodity{}).begin(), runtime_error);
+    dbm.SetScanCheck(nullopt);
+    EXPECT_EQ(dbm.Query(Commodity{}).ToVector().size(), 11);
+}
+
+TEST_F(Sqlite3Unittest, IndexTest) {
+    DBManager<Sqlite3> dbm(":memory:");
+    Commodity c;
+    FieldExtractor field{c};
+    dbm.CreateTbl(c);
+    dbm.InsertRange(vector<Commodity>{{"001", 1, 2.5}, {"002", 2, nullptr}});
+    auto byCount = dbm.Query(Commodity{}).Where(field(c.Count) == 2);
+    EXPECT_EQ(byCount.Explain().ScannedTables(), vector<string>{"Commodity"});
+
+    dbm.CreateIndex(c, "Commodity_Count", Index::Desc(field(c.Count)));
+    EXPECT_TRUE(byCount.Explain().ScannedTables().empty());
+    EXPECT_EQ(byCount.ToVector().size(), 1);
+
+    dbm.CreateIndex(c, "Commodity_Price", Index::Unique(), field(c.Price),
+                    Index::Where(field(c.Price) != nullptr));
+    EXPECT_THROW(dbm.Insert(Commodity{"003", 3, 2.5}), runtime_error);
+    dbm.Insert(Commodity{"003", 3, nullptr});
+
+    auto total = field(c.Count) * 2;
+    dbm.CreateIndex(c, "Commodity_Total", total);
+    auto byTotal = dbm.Query(Commodity{}).Where(total == 6);
+    EXPECT_TRUE(byTotal.Explain().ScannedTables().empty());
+    ASSERT_EQ(byTotal.ToVector().size(), 1);
+    EXPECT_EQ(byTotal.ToVector()[0].ID, string("003"));
+
+    dbm.DropIndex("Commodity_Count");
+    dbm.DropIndex("Commodity_Total");
+    EXPECT_EQ(byCount.Explain().ScannedTables(), vector<string>{"Commodity"});
+    EXPECT_THROW(dbm.DropIndex("Commodity_Count"), runtime_error);
+}
+
+TEST_F(Sqlite3Unittest, ProfileTest) {
+    StatementProfile profile;
+    for (long long ns : {100, 200, 300, 5000}) profile.Add(ns * 1ns, 2);
+    EXPECT_EQ(profile.count, 4);
+    EXPECT_EQ(profile.rows, 8);
+    EXPECT_EQ(profile.total, 5600ns);
+    EXPECT_EQ(profile.Percentile(0.5), 512ns);
+    EXPECT_EQ(profile.Percentile(0.99), 5000ns);
+
+    DBManager<Sqlite3> dbm(":memory:");
+    Commodity c;
+    FieldExtractor field{c};
+    dbm.CreateTbl(c);
+    dbm.InsertRange(vector<Commodity>{{"001", 1, 2.5}, {"002", 2, nullptr}});
+    auto& db = dbm.Backend();
+    db.SetProfiling(true);
+    auto query = dbm.Query(Commodity{}).Where(field(c.Count) >= 1);
+    for (int i = 0; i < 3; ++i) EXPECT_EQ(query.ToVector().size(), 2);
+    for (const auto& row : query) EXPECT_FALSE(row.ID.empty());
+    db.SetProfiling(false);
+    query.ToVector();
+
+    auto stats = db.Profile();
+    string sql = "select * from Commodity where (Commodity.Count>=?);";
+    ASSERT_EQ(stats.statements.count(sql), 1);
+    const auto& select = stats.statements.at(sql);
+    EXPECT_EQ(select.count, 4);
+    EXPECT_EQ(select.rows, 8);
+    EXPECT_GE(select.max, select.Percentile(0.5));
+    EXPECT_EQ(stats.step, select.total);
+    EXPECT_GT(stats.build.count(), 0);
+    EXPECT_GT(stats.prepare.count(), 0);
+    EXPECT_GT(stats.decode.count(), 0);
+
+    db.ResetProfile();
+    EXPECT_TRUE(db.Profile().statements.empty());
+    EXPECT_EQ(db.Profile().build.count(), 0);
+
+    // A pool keeps the phases timed outside of its connections itself.
+    ConnectionPool<Sqlite3> pool(":memory:", 1);
+    pool.SetProfiling(true);
+    pool.AddProfileTime(&ProfileStats::build, 5ns);
+    EXPECT_EQ(pool.Size(), 0);
+    EXPECT_EQ(pool.Profile().build, 5ns);
+    pool.ResetProfile();
+    EXPECT_EQ(pool.Profile().build.count(), 0);
+}
+
+TEST_F(Sqlite3Unittest, SlowQueryLogTest) {
+    DBManager<Sqlite3> dbm(":memory:");
+    Commodity c;
+    FieldExtractor field{c};
+    dbm.CreateTbl(c);
+    dbm.InsertRange(vector<Commodity>{{"001", 1, 2.5}, {"002", 2, nullptr}});
+    vector<SlowQuery> slow;
+    SlowQueryLog log{0ns, [&slow](const SlowQuery& query) {
+                         slow.push_back(query);
+                     }};
+    dbm.SetSlowQueryLog(log);
+    dbm.Query(Commodity{}).Where(field(c.Count) >= 1).ToVector();
+    ASSERT_EQ(slow.size(), 1);
+    EXPECT_EQ(slow[0].sql,
+              string("select * from Commodity where (Commodity.Count>=?);"));
+    EXPECT_EQ(slow[0].values, BoundValues{1LL});
+    EXPECT_EQ(slow[0].rows, 2);
+    EXPECT_GT(slow[0].elapsed.count(), 0);
+    EXPECT_EQ(slow[0].plan.ScannedTables(), vector<string>{"Commodity"});
+
+    log.redactValues = true;
+    dbm.SetSlowQueryLog(log);
+    auto sum = dbm.Query(Commodity{})
+                   .Where(field(c.ID) == string("001"))
+                   .Aggregate(Sum(field(c.Count)));
+    EXPECT_EQ(sum.Value(), 1);
+    ASSERT_EQ(slow.size(), 2);
+    EXPECT_TRUE(slow[1].values.empty());
+    EXPECT_EQ(slow[1].rows, 1);
+    EXPECT_TRUE(slow[1].plan.ScannedTables().empty());
+
+    log.threshold = 1h;
+    dbm.SetSlowQueryLog(log);
+    dbm.Query(Commodity{}).ToVector();
+    dbm.SetSlowQueryLog(nullopt);
+    dbm.Query(Commodity{}).ToVector();
+    EXPECT_EQ(slow.size(), 2);
+}
+
+TEST_F(Sqlite3Unittest, BoundParameterTest) {
+    db.Execute("insert into T values (?, ?);", {1LL, string("O'Neil")});
+    db.Execute("insert into T values (?, ?);", {2LL, nullptr});
+    auto hits = db.CacheStats().hits;
+    for (long long id = 1; id <= 2; ++id) {
+        db.ExecuteCallback("select name from T where id=?;", {id},
+                           [id](int argc, char** argv) {
+                               ASSERT_EQ(argc, 1);
+                               if (id == 1)
+                                   EXPECT_STREQ(argv[0], "O'Neil");
+                               else
+                                   EXPECT_EQ(argv[0], nullptr);
+                           });
+    }
+    EXPECT_EQ(db.CacheStats().hits - hits, 1);
+
+    DBManager<Sqlite3> dbm(":memory:");
+    Commodity c;
+    FieldExtractor field{c};
+    dbm.CreateTbl(c);
+    dbm.InsertRange(vector<Commodity>{{"001", 1, 2.5}, {"002", 2, nullptr}});
+    dbm.Update(c, (field(c.ID) = string("It's")) && (field(c.Price) = nullptr),
+               field(c.ID) == string("001"));
+    auto res = dbm.Query(Commodity{})
+                   .Where(field(c.ID) == string("It's"))
+                   .ToVector();
+    ASSERT_EQ(res.size(), 1);
+    EXPECT_TRUE(res[0].Price == nullptr);
+    dbm.Delete(c, field(c.Count) < 2);
+    EXPECT_EQ(dbm.Query(Commodity{}).Aggregate(Count()).Value(), 1);
+}
+
+TEST_F(Sqlite3Unittest, TypedDecodeTest) {
+    db.Execute("create table D(i integer, r real, s text, n integer);");
+    db.Execute("insert into D values (?, ?, ?, ?);",
+               {-42LL, 2.5, string("Hello World"), nullptr});
+    db.ExecuteCallback("select * from D;", {}, [](sqlite3_stmt* stmt) {
+        long long i;
+        float r;
+        string s;
+        Nullable<int> n, m;
+        Deserializer::Deserialize(i, stmt, 0);
+        Deserializer::Deserialize(r, stmt, 1);
+        Deserializer::Deserialize(s, stmt, 2);
+        Deserializer::Deserialize(n, stmt, 3);
+        Deserializer::Deserialize(m, stmt, 0);
+        EXPECT_EQ(i, -42);
+        EXPECT_EQ(r, 2.5f);
+        EXPECT_EQ(s, string("Hello World"));
+        EXPECT_TRUE(n == nullptr);
+        EXPECT_TRUE(m == -42);
+        int nonNullable;
+        EXPECT_THROW(Deserializer::Deserialize(nonNullable, stmt, 3),
+                     std::runtime_error);
+    });
+}
+
+TEST_F(Sqlite3Unittest, CursorTest) {
+    DBManager<Sqlite3> dbm(":memory:");
+    Commodity c;
+    FieldExtractor field{c};
+    dbm.CreateTbl(c);
+    vector<Commodity> stock;
+    for (int i = 0; i < 100; ++i) {
+        stock.push_back({to_string(1000 + i), i, 0.5 * i});
+        if (i % 2) stock.back().Price = nullptr;
+    }
+    dbm.InsertRange(stock);
+
+    auto query = dbm.Query(Commodity{}).Where(field(c.Count) >= 10);
+    int count = 10;
+    const Commodity* buffer = nullptr;
+    for (auto& row : query) {
+        if (buffer == nullptr) buffer = &row;
+        EXPECT_EQ(&row, buffer);
+        EXPECT_EQ(row.Count, count);
+        EXPECT_EQ(row.ID, to_string(1000 + count));
+        EXPECT_EQ(row.Price == nullptr, count % 2 == 1);
+        ++count;
+    }
+    EXPECT_EQ(count, 100);
+
+    EXPECT_EQ(query.ToVector().size(), 90);
+
+    auto it = dbm.Query(Commodity{})
+                  .Select(field(c.ID), field(c.Price))
+                  .Where(field(c.Count) < 3)
+                  .begin();
+    EXPECT_EQ(std::get<0>(*it).Value(), string("1000"));
+    EXPECT_EQ(std::get<1>(*it++).Value(), 0.0);
+    EXPECT_TRUE(std::get<1>(*it) == nullptr);
+    ++it;
+    ++it;
+    EXPECT_TRUE(it == decltype(it){});
+
+    auto empty = dbm.Query(Commodity{}).Where(field(c.Count) > 100);
+    EXPECT_TRUE(empty.begin() == empty.end());
+
+    // A live cursor keeps its statement busy, an abandoned one releases it.
+    {
+        auto live = query.begin();
+        EXPECT_THROW(dbm.DropTbl(c), std::runtime_error);
+    }
+    for (const auto& row : query) {
+        if (row.Count == 20) break;
+    }
+    EXPECT_NO_THROW(dbm.DropTbl(c));
+}
+
+TEST_F(Sqlite3Unittest, InsertRangeTest) {
+    DBManager<Sqlite3> dbm(":memory:");
+    Commodity c;
+    FieldExtractor field{c};
+    dbm.CreateTbl(c, Constraint::Default(field(c.Price), -1.0));
+    vector<Commodity> stock;
+    for (int i = 0; i < 1000; ++i) {
+        stock.push_back({to_string(i), i, 0.5 * i});
+        if (i % 3 == 0) stock.back().Price = nullptr;
+    }
+    dbm.InsertRange(stock);
+    EXPECT_EQ(dbm.Query(Commodity{}).Aggregate(Count()).Value(), 1000);
+    // NULL fields are skipped, so the default value applies.
+    EXPECT_EQ(dbm.Query(Commodity{})
+                  .Where(field(c.Price) == -1.0)
+                  .Aggregate(Count())
+                  .Value(),
+              334);
+
+    // A failing entity rolls back the whole range.
+    vector<Commodity> duplicated = {{"new", 1, 1.0}, {"0", 2, 2.0}};
+    EXPECT_THROW(dbm.InsertRange(duplicated), std::runtime_error);
+    EXPECT_EQ(dbm.Query(Commodity{}).Aggregate(Count()).Value(), 1000);
+
+    // Nested in a transaction, the range is committed with it.
+    dbm.Transaction([&dbm]() {
+        dbm.InsertRange(vector<Commodity>{{"a", 1, 1.0}, {"b", 2, nullptr}});
+    });
+    EXPECT_EQ(dbm.Query(Commodity{}).Aggregate(Count()).Value(), 1002);
+}
+
+TEST_F(Sqlite3Unittest, MultiRowInsertTest) {
+    DBManager<Sqlite3> dbm(":memory:");
+    Commodity c;
+    FieldExtractor field{c};
+    dbm.CreateTbl(c, Constraint::Default(field(c.Price), -1.0));
+    // Enough rows for many full batches plus a tail.
+    const int rows = 40007;
+    vector<Commodity> stock;
+    for (int i = 0; i < rows; ++i) {
+        stock.push_back({to_string(i), i, 0.5 * i});
+        if (i % 1000 == 0) stock.back().Price = nullptr;
+    }
+    dbm.InsertRange(stock, true, InsertMode::MultiRow);
+    EXPECT_EQ(dbm.Query(Commodity{}).Aggregate(Count()).Value(), rows);
+    EXPECT_EQ(dbm.Query(Commodity{})
+                  .Where(field(c.Price) == -1.0)
+                  .Aggregate(Count())
+                  .Value(),
+              (rows + 999) / 1000);
+    auto last = dbm.Query(Commodity{})
+                    .Where(field(c.ID) == to_string(rows - 1))
+                    .ToVector();
+    ASSERT_EQ(last.size(), 1);
+    EXPECT_EQ(last[0].Count, rows - 1);
+    EXPECT_DOUBLE_EQ(last[0].Price.Value(), 0.5 * (rows - 1));
+
+    vector<Commodity> duplicated = {{"new", 1, 1.0}, {"0", 2, 2.0}};
+    EXPECT_THROW(dbm.InsertRange(duplicated, true, InsertMode::MultiRow),
+                 std::runtime_error);
+    EXPECT_EQ(dbm.Query(Commodity{}).Aggregate(Count()).Value(), rows);
+}
+
+TEST_F(Sqlite3Unittest, ConnectionPoolTest) {
+    const string file = "tinyorm_pool_unittest.db";
+    std::remove(file.c_str());
+    {
+        using Pool = ConnectionPool<Sqlite3>;
+        DBManager<Pool> dbm(file, 2);
+        Commodity c;
+        FieldExtractor field{c};
+        dbm.CreateTbl(c);
+        vector<Commodity> stock;
+        for (int i = 0; i < 100; ++i) stock.push_back({to_string(i), i, 0.5});
+        dbm.InsertRange(stock);
+
+        // A live cursor holds one connection, another thread reads on the
+        // second one.
+        auto query = dbm.Query(Commodity{});
+        auto it = query.begin();
+        auto reader = std::async(std::launch::async, [&dbm]() {
+            return dbm.Query(Commodity{}).Aggregate(Count()).Value();
+        });
+        EXPECT_EQ(reader.get(), 100);
+        EXPECT_EQ(it->ID, "0");
+
+        it = query.end();
+
+        // Async workers check their connections out of the same pool.
+        auto backend = dbm.Async([](DBManager<Pool>& worker) {
+                              worker.Query(Commodity{}).ToVector();
+                              return &worker.Backend();
+                          }).get();
+        EXPECT_EQ(backend, &dbm.Backend());
+        EXPECT_EQ(dbm.Backend().Size(), 2);
+
+        // The connection stays with its thread while the transaction is open.
+        dbm.Transaction([&dbm, &field, &c]() {
+            dbm.Delete(Commodity{}, field(c.Count) >= 50);
+            EXPECT_EQ(dbm.Query(Commodity{}).Aggregate(Count()).Value(), 50);
+        });
+        EXPECT_EQ(dbm.Query(Commodity{}).Aggregate(Count()).Value(), 50);
+
+        Pool pool(file, 1);
+        auto conn = pool.Acquire();
+        auto blocked = std::async(std::launch::async, [&pool]() {
+            size_t rows = 0;
+            pool.ExecuteCallback("select * from Commodity;",
+                                 [&rows](int, char**) { ++rows; });
+            return rows;
+        });
+        EXPECT_EQ(blocked.wait_for(std::chrono::milliseconds(50)),
+                  std::future_status::timeout);
+        {
+            auto returned = std::move(conn);
+        }
+        EXPECT_EQ(blocked.get(), 50);
+        EXPECT_EQ(pool.Size(), 1);
+        EXPECT_EQ(dbm.Query(Commodity{}).Aggregate(Count()).Value(), 50);
+    }
+    std::remove(file.c_str());
+}
+
+TEST_F(Sqlite3Unittest, OptionsTest) {
+    using Options = Sqlite3Options;
+    const string file = "tinyorm_options_unittest.db";
+    std::remove(file.c_str());
+    {
+        Options options;
+        options.pageSize = 8192;
+        options.journalMode = Options::JournalMode::Wal;
+        options.synchronous = Options::Synchronous::Normal;
+        options.cacheSize = -4096;
+        options.mmapSize = 1 << 20;
+        options.tempStore = Options::TempStore::Memory;
+        options.busyTimeout = 250;
+
+        DBManager<Sqlite3> dbm(file, options);
+        auto effective = dbm.Options();
+        EXPECT_EQ(effective.pageSize, 8192);
+        EXPECT_EQ(effective.journalMode, Options::JournalMode::Wal);
+        EXPECT_EQ(effective.synchronous, Options::Synchronous::Normal);
+        EXPECT_EQ(effective.cacheSize, -4096);
+        EXPECT_EQ(effective.tempStore, Options::TempStore::Memory);
+        EXPECT_EQ(effective.busyTimeout, 250);
+        // mmap may be capped or disabled by the SQLite build.
+        EXPECT_LE(*effective.mmapSize, 1 << 20);
+
+        // Every pooled connection gets the same options.
+        DBManager<ConnectionPool<Sqlite3>> pooled(file, 2, options);
+        auto conn = std::async(std::launch::async, [&pooled]() {
+                        return pooled.Options();
+                    }).get();
+        EXPECT_EQ(conn.synchronous, Options::Synchronous::Normal);
+        EXPECT_EQ(conn.busyTimeout, 250);
+        EXPECT_EQ(pooled.Options().tempStore, Options::TempStore::Memory);
+
+        // Unset options keep the defaults, in-memory databases can't use WAL.
+        Options wal;
+        wal.journalMode = Options::JournalMode::Wal;
+        Sqlite3 memory(":memory:", wal);
+        EXPECT_EQ(memory.Options().journalMode, Options::JournalMode::Memory);
+        EXPECT_EQ(memory.Options().busyTimeout, 0);
+    }
+    std::remove(file.c_str());
+    std::remove((file + "-wal").c_str());
+    std::remove((file + "-shm").c_str());
+}
+
+TEST_F(Sqlite3Unittest, BusyPolicyTest) {
+    using namespace std::chrono;
+    const string file = "tinyorm_busy_unittest.db";
+    std::remove(file.c_str());
+    {
+        Sqlite3 writer(file);
+        writer.Execute("create table T(id integer primary key);");
+        for (auto mode :
+             {BusyPolicy::Mode::Backoff, BusyPolicy::Mode::Handler}) {
+            BusyPolicy policy;
+            policy.mode = mode;
+            policy.deadline = milliseconds(30);
+            Sqlite3Options options;
+            options.busyPolicy = policy;
+            Sqlite3 waiter(file, options);
+
+            // The lock outlives the deadline.
+            writer.Execute("begin immediate;");
+            auto start = steady_clock::now();
+            EXPECT_THROW(waiter.Execute("insert into T values (1);"),
+                         std::runtime_error);
+            EXPECT_GE(steady_clock::now() - start, milliseconds(15));
+            auto stats = waiter.BusyStats();
+            EXPECT_EQ(stats.events, 1);
+            EXPECT_EQ(stats.timeouts, 1);
+            EXPECT_GT(stats.retries, 1);
+            EXPECT_GT(stats.waited.count(), 0);
+
+            // The lock is released before the deadline.
+            policy.deadline = seconds(5);
+            waiter.SetBusyPolicy(policy);
+            auto release = std::async(std::launch::async, [&writer]() {
+                std::this_thread::sleep_for(milliseconds(20));
+                writer.Execute("commit;");
+            });
+            waiter.Execute("insert into T values (2);");
+            release.get();
+            EXPECT_EQ(waiter.BusyStats().events, 2);
+            EXPECT_EQ(waiter.BusyStats().timeouts, 1);
+            waiter.Execute("delete from T;");
+        }
+    }
+    std::remove(file.c_str());
+}
+
+TEST_F(Sqlite3Unittest, AsyncTest) {
+    const string file = "tinyorm_async_unittest.db";
+    std::remove(file.c_str());
+    {
+        DBManager<Sqlite3> dbm(file);
+        dbm.SetAsyncWorkers(1);
+        Commodity c;
+        FieldExtractor field{c};
+        dbm.CreateTbl(c);
+
+        vector<Commodity> stock;
+        for (int i = 0; i < 100; ++i) stock.push_back({to_string(i), i, 0.5});
+        auto inserted = dbm.InsertRangeAsync(stock);
+        auto single = dbm.InsertAsync(Commodity{"100", 100, nullptr});
+        inserted.get();
+        single.get();
+        EXPECT_EQ(dbm.Query(Commodity{}).Aggregate(Count()).Value(), 101);
+
+        // Queries keep their bound values on the worker.
+        auto rows =
+            dbm.Query(Commodity{}).Where(field(c.Count) < 10).ToVectorAsync();
+        auto priced = dbm.Query(Commodity{})
+                          .Where(field(c.Price) == nullptr)
+                          .AggregateAsync(Count());
+        EXPECT_EQ(rows.get().size(), 10);
+        EXPECT_EQ(priced.get().Value(), 1);
+
+        auto updated = dbm.UpdateAsync(Commodity{}, field(c.Price) = 2.0,
+                                       field(c.Count) >= 50);
+        auto deleted = dbm.DeleteAsync(Commodity{}, field(c.Count) < 10);
+        updated.get();
+        deleted.get();
+        EXPECT_EQ(dbm.Query(Commodity{})
+                      .Where(field(c.Price) == 2.0)
+                      .Aggregate(Count())
+                      .Value(),
+                  51);
+        EXPECT_EQ(dbm.Query(Commodity{}).Aggregate(Count()).Value(), 91);
+
+        // Errors of the worker surface through the future.
+        auto duplicated = dbm.InsertAsync(Commodity{"100", 1, 1.0});
+        EXPECT_THROW(duplicated.get(), std::runtime_error);
+
+        // Nested async operations run at once on the worker of their caller.
+        auto nested = dbm.Async([&](DBManager<Sqlite3>& worker) {
+            worker.InsertAsync(Commodity{"101", 101, 1.0}).get();
+            auto inner = worker.Async([](DBManager<Sqlite3>&) {
+                                   return std::this_thread::get_id();
+                               }).get();
+            EXPECT_EQ(inner, std::this_thread::get_id());
+            return worker.Query(Commodity{})
+                .Where(field(c.Count) > 100)
+                .AggregateAsync(Count())
+                .get()
+                .Value();
+        });
+        EXPECT_EQ(nested.get(), 1);
+
+        // So do the slow query log and the scan check of the manager.
+        vector<string> slow;
+        dbm.SetSlowQueryLog(
+            SlowQueryLog{0ns, [&slow](const SlowQuery& query) {
+                             slow.push_back(query.sql);
+                         }});
+        dbm.Query(Commodity{}).Where(field(c.Count) < 20).ToVectorAsync().get();
+        dbm.Async([](DBManager<Sqlite3>& worker) {
+               worker.Query(Commodity{}).ToVector();
+           }).get();
+        EXPECT_EQ(slow.size(), 2);
+        dbm.SetSlowQueryLog(nullopt);
+        ScanCheck check;
+        check.maxRows = 10;
+        dbm.SetScanCheck(check);
+        auto scanned = dbm.Async([](DBManager<Sqlite3>& worker) {
+            return worker.Query(Commodity{}).ToVector();
+        });
+        EXPECT_THROW(scanned.get(), std::runtime_error);
+        dbm.SetScanCheck(nullopt);
+
+        auto workerThread = dbm.Async([](DBManager<Sqlite3>&) {
+                                   return std::this_thread::get_id();
+                               }).get();
+        EXPECT_NE(workerThread, std::this_thread::get_id());
+
+        // The last reference to an executor may be dropped by its worker.
+        auto executor = std::make_shared<Executor<Sqlite3>>(
+            [&file]() { return std::make_shared<Sqlite3>(file); }, 1);
+        std::promise<void> released, dropped;
+        executor->Post([keep = executor, wait = released.get_future().share(),
+                        &dropped](std::shared_ptr<Sqlite3>&) mutable {
+            wait.wait();
+            keep.reset();
+            dropped.set_value();
+        });
+        executor.reset();
+        released.set_value();
+        dropped.get_future().get();
+
+        // Shutting down runs the pending tasks, and rejects later ones.
+        Executor<Sqlite3> stopped(
+            [&file]() { return std::make_shared<Sqlite3>(file); }, 1);
+        auto pending =
+            stopped.Submit([](const std::shared_ptr<Sqlite3>&) { return 1; });
+        stopped.Shutdown();
+        EXPECT_EQ(pending.get(), 1);
+        EXPECT_THROW(
+            stopped.Submit([](const std::shared_ptr<Sqlite3>&) { return 2; }),
+            std::runtime_error);
+    }
+    std::remove(file.c_str());
+}